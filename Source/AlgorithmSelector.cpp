@@ -1,39 +1,104 @@
-/*
-  ==============================================================================
-
-    AlgorithmSelector.cpp
-    Created: 18 Nov 2024 12:07:58pm
-    Author:  Leif Rehtanz
-
-  ==============================================================================
-*/
-
-#include "AlgorithmSelector.h"
-
-AlgorithmSelector::AlgorithmSelector()
-{
-    addAndMakeVisible(algorithmDropdown);
-
-    algorithmDropdown.addItem("Amplitude Threshold", 1);
-    algorithmDropdown.addItem("Spectral Analysis", 2);
-    algorithmDropdown.setSelectedId(1); // Default to first algorithm
-
-    algorithmDropdown.onChange = [this]() { selectionChanged(); };
-}
-
-void AlgorithmSelector::selectionChanged()
-{
-    if (algorithmChanged) // Trigger the callback
-        algorithmChanged();
-}
-
-juce::String AlgorithmSelector::getSelectedAlgorithm() const
-{
-    return algorithmDropdown.getText();
-}
-
-void AlgorithmSelector::resized()
-{
-    auto area = getLocalBounds().reduced(10);
-    algorithmDropdown.setBounds(area);
-}
+/*
+  ==============================================================================
+
+    AlgorithmSelector.cpp
+    Created: 18 Nov 2024 12:07:58pm
+    Author:  Leif Rehtanz
+
+  ==============================================================================
+*/
+
+#include "AlgorithmSelector.h"
+
+AlgorithmSelector::AlgorithmSelector()
+{
+    addAndMakeVisible(algorithmDropdown);
+
+    // Item IDs are registry positions plus one, since 0 means no selection
+    const auto& entries = DeEssEngineRegistry::getEntries();
+
+    for (int i = 0; i < entries.size(); ++i)
+        algorithmDropdown.addItem(entries.getReference(i).name, i + 1);
+
+    algorithmDropdown.setSelectedId(1); // Default to first algorithm
+
+    algorithmDropdown.onChange = [this]() { selectionChanged(); };
+
+    addAndMakeVisible(detectionDropdown);
+    addAndMakeVisible(intervalDropdown);
+
+    // Item IDs are Detection::Mode values plus one
+    detectionDropdown.addItem("Per-sample detection", 1);
+    detectionDropdown.addItem("Peak every N samples", 2);
+    detectionDropdown.addItem("RMS every N samples", 3);
+    detectionDropdown.setSelectedId(1);
+
+    // Item IDs are the intervals themselves
+    for (int interval : { 8, 16, 32, 64 })
+        intervalDropdown.addItem("N = " + juce::String(interval), interval);
+
+    intervalDropdown.setSelectedId(DeEssEngine::Detection().controlInterval);
+    intervalDropdown.setEnabled(false);
+
+    detectionDropdown.onChange = [this]() { detectionSelectionChanged(); };
+    intervalDropdown.onChange = [this]() { detectionSelectionChanged(); };
+
+    latencyLabel.setJustificationType(juce::Justification::centredRight);
+    latencyLabel.setColour(juce::Label::textColourId, juce::Colours::grey);
+    addAndMakeVisible(latencyLabel);
+}
+
+void AlgorithmSelector::setLatency(int latencySamples, double sampleRate)
+{
+    auto text = "Latency: " + juce::String(latencySamples) + " samples";
+
+    if (sampleRate > 0.0)
+        text << " (" << juce::String(1000.0 * latencySamples / sampleRate, 1) << " ms)";
+
+    latencyLabel.setText(text, juce::dontSendNotification);
+}
+
+void AlgorithmSelector::selectionChanged()
+{
+    if (algorithmChanged) // Trigger the callback
+        algorithmChanged();
+}
+
+void AlgorithmSelector::detectionSelectionChanged()
+{
+    // The interval means nothing to the per-sample gate
+    intervalDropdown.setEnabled(detectionDropdown.getSelectedId() > 1);
+
+    if (detectionChanged)
+        detectionChanged();
+}
+
+DeEssEngine::Detection AlgorithmSelector::getDetection() const
+{
+    DeEssEngine::Detection detection;
+    detection.mode = (DeEssEngine::Detection::Mode) juce::jlimit(0, 2, detectionDropdown.getSelectedId() - 1);
+    detection.controlInterval = intervalDropdown.getSelectedId();
+
+    return detection;
+}
+
+DeEssEngineRegistry::Algorithm AlgorithmSelector::getSelectedAlgorithm() const
+{
+    const auto& entries = DeEssEngineRegistry::getEntries();
+    const int index = juce::jlimit(0, entries.size() - 1, algorithmDropdown.getSelectedId() - 1);
+
+    return entries.getReference(index).algorithm;
+}
+
+void AlgorithmSelector::resized()
+{
+    auto area = getLocalBounds().reduced(10);
+    auto detectionRow = area.removeFromBottom(area.getHeight() / 2);
+
+    latencyLabel.setBounds(area.removeFromRight(190).withTrimmedBottom(2));
+    area.removeFromRight(4);
+    algorithmDropdown.setBounds(area.withTrimmedBottom(2));
+    intervalDropdown.setBounds(detectionRow.removeFromRight(90).withTrimmedTop(2));
+    detectionRow.removeFromRight(4);
+    detectionDropdown.setBounds(detectionRow.withTrimmedTop(2));
+}
@@ -1,34 +1,44 @@
-/*
-  ==============================================================================
-
-    AlgorithmSelector.h
-    Created: 18 Nov 2024 12:08:07pm
-    Author:  Leif Rehtanz
-
-  ==============================================================================
-*/
-
-#pragma once
-
-#include <JuceHeader.h>
-#include <functional>
-
-class AlgorithmSelector : public juce::Component
-{
-public:
-    AlgorithmSelector();
-    ~AlgorithmSelector() override = default;
-
-    juce::String getSelectedAlgorithm() const;
-
-    std::function<void()> algorithmChanged; // Callback for when algorithm changes
-    
-    void resized() override;
-
-private:
-    juce::ComboBox algorithmDropdown;
-
-    void selectionChanged();
-
-    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(AlgorithmSelector)
-};
+/*
+  ==============================================================================
+
+    AlgorithmSelector.h
+    Created: 18 Nov 2024 12:08:07pm
+    Author:  Leif Rehtanz
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <functional>
+#include "DeEssEngineRegistry.h"
+
+class AlgorithmSelector : public juce::Component
+{
+public:
+    AlgorithmSelector();
+    ~AlgorithmSelector() override = default;
+
+    DeEssEngineRegistry::Algorithm getSelectedAlgorithm() const;
+    DeEssEngine::Detection getDetection() const;
+
+    // Shows the processing delay next to the algorithm; no time without a sample rate
+    void setLatency(int latencySamples, double sampleRate);
+
+    std::function<void()> algorithmChanged; // Callback for when algorithm changes
+    std::function<void()> detectionChanged; // Callback for when detection mode or interval changes
+    
+    void resized() override;
+
+private:
+    juce::ComboBox algorithmDropdown;
+    juce::ComboBox detectionDropdown;
+    juce::ComboBox intervalDropdown;
+    juce::Label latencyLabel;
+
+    void selectionChanged();
+    void detectionSelectionChanged();
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(AlgorithmSelector)
+};
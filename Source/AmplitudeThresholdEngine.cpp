@@ -0,0 +1,390 @@
+/*
+  ==============================================================================
+
+    AmplitudeThresholdEngine.cpp
+    Created: 18 Oct 2026 1:48:22am
+    Author:  Leif Rehtanz
+
+  ==============================================================================
+*/
+
+#include "AmplitudeThresholdEngine.h"
+
+AmplitudeThresholdEngine::AmplitudeThresholdEngine()
+    : kernels(DeEssKernels::getBestKernels())
+{
+    crossover.setCutoffFrequency(currentFrequency);
+}
+
+void AmplitudeThresholdEngine::prepare(double sampleRate, int maximumBlockSize, int numChannels)
+{
+    maxBlockSize = juce::jmax(1, maximumBlockSize);
+    numPreparedChannels = juce::jmax(0, numChannels);
+    currentSampleRate = sampleRate;
+
+    // Start from the latest parameters without ramping towards them
+    currentFrequency = juce::jlimit(20.0f, (float) (sampleRate * 0.49), targetFrequency);
+
+    thresholdGain.reset(sampleRate, thresholdRampSeconds);
+    thresholdGain.setCurrentAndTargetValue(juce::Decibels::decibelsToGain(targetThresholdDb));
+    mixGain.reset(sampleRate, mixRampSeconds);
+    mixGain.setCurrentAndTargetValue(juce::Decibels::decibelsToGain(targetMixDb));
+
+    juce::dsp::ProcessSpec spec { sampleRate, static_cast<juce::uint32>(maxBlockSize), static_cast<juce::uint32>(numPreparedChannels) };
+    crossover.prepare(spec);
+    crossover.setCutoffFrequency(currentFrequency);
+    crossover.reset();
+
+    sibilantBuffer.setSize(numPreparedChannels, maxBlockSize, false, true, false);
+    originalBuffer.setSize(numPreparedChannels, maxBlockSize, false, true, false);
+
+    thresholdRamp.assign(static_cast<size_t>(maxBlockSize), 0.0f);
+    mixRamp.assign(static_cast<size_t>(maxBlockSize), 0.0f);
+
+    hysteresisCounters.assign(static_cast<size_t>(numPreparedChannels), 0);
+
+    controlGains.assign(static_cast<size_t>(numPreparedChannels), 1.0f);
+    controlTargets.assign(static_cast<size_t>(numPreparedChannels), 1.0f);
+    controlLevels.assign(static_cast<size_t>(numPreparedChannels), 0.0f);
+    gainCurve.assign(static_cast<size_t>(maxBlockSize), 0.0f);
+    resetControlState();
+
+    processFunction = usesFixedLayouts ? chooseProcessFunction(numPreparedChannels, maxBlockSize)
+                                       : &AmplitudeThresholdEngine::processGeneric;
+}
+
+AmplitudeThresholdEngine::ProcessFunction AmplitudeThresholdEngine::chooseProcessFunction(int numChannels, int blockSize)
+{
+    // The manager slices at the prepared size, so full blocks are exactly that long
+    switch (numChannels)
+    {
+        case 1:
+            switch (blockSize)
+            {
+                case 64:  return &AmplitudeThresholdEngine::processFixedLayout<1, 64>;
+                case 128: return &AmplitudeThresholdEngine::processFixedLayout<1, 128>;
+                case 256: return &AmplitudeThresholdEngine::processFixedLayout<1, 256>;
+                default:  return &AmplitudeThresholdEngine::processFixedLayout<1, 0>;
+            }
+
+        case 2:
+            switch (blockSize)
+            {
+                case 64:  return &AmplitudeThresholdEngine::processFixedLayout<2, 64>;
+                case 128: return &AmplitudeThresholdEngine::processFixedLayout<2, 128>;
+                case 256: return &AmplitudeThresholdEngine::processFixedLayout<2, 256>;
+                default:  return &AmplitudeThresholdEngine::processFixedLayout<2, 0>;
+            }
+
+        default:
+            return &AmplitudeThresholdEngine::processGeneric;
+    }
+}
+
+void AmplitudeThresholdEngine::reset()
+{
+    crossover.reset();
+    std::fill(hysteresisCounters.begin(), hysteresisCounters.end(), 0);
+    resetControlState();
+}
+
+void AmplitudeThresholdEngine::setDetection(const Detection& newDetection)
+{
+    auto clamped = newDetection;
+    clamped.controlInterval = juce::jlimit(Detection::minControlInterval, Detection::maxControlInterval,
+                                           newDetection.controlInterval);
+
+    if (clamped == detection)
+        return;
+
+    detection = clamped;
+
+    // Carry on from wherever the gate was, without a jump
+    resetControlState();
+}
+
+void AmplitudeThresholdEngine::resetControlState()
+{
+    const auto gatedGain = mixGain.getCurrentValue();
+
+    for (size_t channel = 0; channel < controlGains.size(); ++channel)
+    {
+        controlGains[channel] = hysteresisCounters[channel] > 0 ? gatedGain : 1.0f;
+        controlTargets[channel] = controlGains[channel];
+        controlLevels[channel] = 0.0f;
+    }
+
+    controlPosition = 0;
+}
+
+void AmplitudeThresholdEngine::setParameters(float thresholdDb, float mixDb, float frequency, int newHysteresisSamples)
+{
+    targetThresholdDb = thresholdDb;
+    targetMixDb = mixDb;
+    targetFrequency = frequency;
+    hysteresisSamples = juce::jmax(1, newHysteresisSamples);
+
+    if (maxBlockSize == 0)
+        return;
+
+    // Coefficients are only recomputed at block boundaries, and only when the
+    // cutoff actually moved
+    auto newFrequency = juce::jlimit(20.0f, (float) (currentSampleRate * 0.49), frequency);
+    if (newFrequency != currentFrequency)
+    {
+        currentFrequency = newFrequency;
+        crossover.setCutoffFrequency(currentFrequency);
+    }
+
+    // Threshold and mix ramp per sample towards the new targets
+    thresholdGain.setTargetValue(juce::Decibels::decibelsToGain(thresholdDb));
+    mixGain.setTargetValue(juce::Decibels::decibelsToGain(mixDb));
+}
+
+bool AmplitudeThresholdEngine::getState(State& state) const
+{
+    jassert(! thresholdGain.isSmoothing() && ! mixGain.isSmoothing());
+
+    state.filterState.resize(crossover.getStateSize());
+    crossover.copyStateTo(state.filterState.data());
+    state.hysteresisCounters = hysteresisCounters;
+    state.controlState.clear();
+
+    if (detection.mode != Detection::Mode::perSample)
+    {
+        state.controlState.insert(state.controlState.end(), controlGains.begin(), controlGains.end());
+        state.controlState.insert(state.controlState.end(), controlTargets.begin(), controlTargets.end());
+        state.controlState.insert(state.controlState.end(), controlLevels.begin(), controlLevels.end());
+        state.controlState.push_back((float) controlPosition);
+    }
+
+    return true;
+}
+
+bool AmplitudeThresholdEngine::setState(const State& newState)
+{
+    // Only states taken from an engine prepared the same way fit
+    jassert(newState.filterState.size() == crossover.getStateSize());
+    jassert(newState.hysteresisCounters.size() == hysteresisCounters.size());
+
+    if (newState.filterState.size() != crossover.getStateSize()
+         || newState.hysteresisCounters.size() != hysteresisCounters.size())
+        return false;
+
+    const auto numChannels = controlGains.size();
+    const auto controlStateSize = detection.mode != Detection::Mode::perSample ? 3 * numChannels + 1 : 0;
+    jassert(newState.controlState.size() == controlStateSize);
+
+    if (newState.controlState.size() != controlStateSize)
+        return false;
+
+    crossover.copyStateFrom(newState.filterState.data());
+    hysteresisCounters = newState.hysteresisCounters;
+
+    if (controlStateSize > 0)
+    {
+        auto source = newState.controlState.begin();
+        std::copy(source, source + (std::ptrdiff_t) numChannels, controlGains.begin());
+        std::copy(source + (std::ptrdiff_t) numChannels, source + (std::ptrdiff_t) (2 * numChannels), controlTargets.begin());
+        std::copy(source + (std::ptrdiff_t) (2 * numChannels), source + (std::ptrdiff_t) (3 * numChannels), controlLevels.begin());
+        controlPosition = (int) newState.controlState.back();
+    }
+
+    return true;
+}
+
+void AmplitudeThresholdEngine::process(juce::AudioBuffer<float>& buffer, int startSample, int numSamples)
+{
+    if (detection.mode != Detection::Mode::perSample)
+        return processControlRate(buffer, startSample, numSamples);
+
+    (this->*processFunction)(buffer, startSample, numSamples);
+}
+
+void AmplitudeThresholdEngine::renderRamps(int numSamples, const float*& thresholds, const float*& gains)
+{
+    // Only render per-sample ramps while a parameter is actually moving, so
+    // the kernels can use a single broadcast value the rest of the time
+    thresholds = nullptr;
+    gains = nullptr;
+
+    if (thresholdGain.isSmoothing())
+    {
+        for (int sample = 0; sample < numSamples; ++sample)
+            thresholdRamp[(size_t) sample] = thresholdGain.getNextValue();
+
+        thresholds = thresholdRamp.data();
+    }
+
+    if (mixGain.isSmoothing())
+    {
+        for (int sample = 0; sample < numSamples; ++sample)
+            mixRamp[(size_t) sample] = mixGain.getNextValue();
+
+        gains = mixRamp.data();
+    }
+}
+
+void AmplitudeThresholdEngine::processGeneric(juce::AudioBuffer<float>& buffer, int startSample, int numSamples)
+{
+    const int numChannels = juce::jmin(buffer.getNumChannels(), numPreparedChannels);
+
+    const float* thresholds = nullptr;
+    const float* gains = nullptr;
+    renderRamps(numSamples, thresholds, gains);
+
+    // One crossover pass writes the phase-aligned original and the sibilant band
+    juce::dsp::AudioBlock<const float> inputBlock(buffer.getArrayOfReadPointers(), (size_t) numChannels,
+                                                  (size_t) startSample, (size_t) numSamples);
+    juce::dsp::AudioBlock<float> originalBlock(originalBuffer);
+    juce::dsp::AudioBlock<float> sibilantBlock(sibilantBuffer);
+    crossover.processCrossover(inputBlock, originalBlock, sibilantBlock);
+    
+    // Process each channel for sibilant detection and removal
+    for (int channel = 0; channel < numChannels; ++channel)
+    {
+        kernels.hysteresisGate(originalBuffer.getWritePointer(channel),
+                               sibilantBuffer.getWritePointer(channel),
+                               numSamples,
+                               thresholdGain.getCurrentValue(), thresholds,
+                               hysteresisSamples, hysteresisCounters[(size_t) channel]);
+    }
+    
+    // Mix adjusted sibilants back into the original signal
+    for (int channel = 0; channel < numChannels; ++channel)
+    {
+        kernels.mixSibilants(buffer.getWritePointer(channel, startSample),
+                             originalBuffer.getReadPointer(channel),
+                             sibilantBuffer.getReadPointer(channel),
+                             mixGain.getCurrentValue(), gains,
+                             numSamples);
+    }
+}
+
+template <int NumChannels, int BlockSize>
+void AmplitudeThresholdEngine::processFixedLayout(juce::AudioBuffer<float>& buffer, int startSample, int numSamples)
+{
+    if constexpr (BlockSize > 0)
+    {
+        // The last slice of a long buffer, or a short host block
+        if (numSamples != BlockSize)
+            return processFixedLayout<NumChannels, 0>(buffer, startSample, numSamples);
+    }
+
+    if (buffer.getNumChannels() < NumChannels)
+        return processGeneric(buffer, startSample, numSamples);
+
+    const int count = BlockSize > 0 ? BlockSize : numSamples;
+
+    const float* thresholds = nullptr;
+    const float* gains = nullptr;
+    renderRamps(count, thresholds, gains);
+
+    // Channel pointers resolved once, into arrays the compiler can see the size of
+    float* channels[NumChannels];
+    float* original[NumChannels];
+    float* sibilant[NumChannels];
+
+    for (int channel = 0; channel < NumChannels; ++channel)
+    {
+        channels[channel] = buffer.getWritePointer(channel, startSample);
+        original[channel] = originalBuffer.getWritePointer(channel);
+        sibilant[channel] = sibilantBuffer.getWritePointer(channel);
+    }
+
+    crossover.processCrossover<NumChannels, BlockSize>(channels, original, sibilant, count);
+
+    for (int channel = 0; channel < NumChannels; ++channel)
+        kernels.hysteresisGate(original[channel], sibilant[channel], count,
+                               thresholdGain.getCurrentValue(), thresholds,
+                               hysteresisSamples, hysteresisCounters[(size_t) channel]);
+
+    for (int channel = 0; channel < NumChannels; ++channel)
+        kernels.mixSibilants(channels[channel], original[channel], sibilant[channel],
+                             mixGain.getCurrentValue(), gains, count);
+}
+
+void AmplitudeThresholdEngine::processControlRate(juce::AudioBuffer<float>& buffer, int startSample, int numSamples)
+{
+    const int numChannels = juce::jmin(buffer.getNumChannels(), numPreparedChannels);
+    const int interval = detection.controlInterval;
+    const bool usePeak = detection.mode == Detection::Mode::peak;
+    const float stepPerSample = 1.0f / (float) interval;
+
+    const float* thresholds = nullptr;
+    const float* gains = nullptr;
+    renderRamps(numSamples, thresholds, gains);
+
+    juce::dsp::AudioBlock<const float> inputBlock(buffer.getArrayOfReadPointers(), (size_t) numChannels,
+                                                  (size_t) startSample, (size_t) numSamples);
+    juce::dsp::AudioBlock<float> originalBlock(originalBuffer);
+    juce::dsp::AudioBlock<float> sibilantBlock(sibilantBuffer);
+    crossover.processCrossover(inputBlock, originalBlock, sibilantBlock);
+
+    int endPosition = controlPosition;
+
+    for (int channel = 0; channel < numChannels; ++channel)
+    {
+        auto* sibilant = sibilantBuffer.getWritePointer(channel);
+        auto& gain = controlGains[(size_t) channel];
+        auto& target = controlTargets[(size_t) channel];
+        auto& level = controlLevels[(size_t) channel];
+        auto& counter = hysteresisCounters[(size_t) channel];
+        int position = controlPosition;
+
+        for (int start = 0; start < numSamples;)
+        {
+            const int count = juce::jmin(interval - position, numSamples - start);
+
+            const auto step = (target - gain) * stepPerSample;
+
+            // Gain minus one, as the original still contains the band being scaled
+            for (int i = 0; i < count; ++i)
+                gainCurve[(size_t) (start + i)] = gain + step * (float) (position + i + 1) - 1.0f;
+
+            if (usePeak)
+            {
+                const auto range = juce::FloatVectorOperations::findMinAndMax(sibilant + start, count);
+                level = juce::jmax(level, -range.getStart(), range.getEnd());
+            }
+            else
+            {
+                float sum[4] = {};
+
+                for (int i = 0; i + 3 < count; i += 4)
+                    for (int lane = 0; lane < 4; ++lane)
+                        sum[lane] += sibilant[start + i + lane] * sibilant[start + i + lane];
+
+                for (int i = count & ~3; i < count; ++i)
+                    sum[0] += sibilant[start + i] * sibilant[start + i];
+
+                level += (sum[0] + sum[1]) + (sum[2] + sum[3]);
+            }
+
+            position += count;
+            start += count;
+
+            if (position == interval)
+            {
+                // The decision for the stretch just finished sets where the next one glides to
+                const auto threshold = thresholds != nullptr ? thresholds[start - 1] : thresholdGain.getCurrentValue();
+                const auto detected = usePeak ? level : std::sqrt(level / (float) interval);
+
+                counter = detected > threshold ? hysteresisSamples : juce::jmax(0, counter - interval);
+
+                gain = target;
+                target = counter > 0 ? (gains != nullptr ? gains[start - 1] : mixGain.getCurrentValue()) : 1.0f;
+                level = 0.0f;
+                position = 0;
+            }
+        }
+
+        endPosition = position;
+
+        // The interpolated gains go through the same mix kernel as a parameter ramp
+        kernels.mixSibilants(buffer.getWritePointer(channel, startSample), originalBuffer.getReadPointer(channel),
+                             sibilant, 0.0f, gainCurve.data(), numSamples);
+    }
+
+    controlPosition = endPosition;
+}
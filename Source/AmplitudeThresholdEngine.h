@@ -0,0 +1,125 @@
+/*
+  ==============================================================================
+
+    AmplitudeThresholdEngine.h
+    Created: 18 Oct 2026 1:48:22am
+    Author:  Leif Rehtanz
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "DeEssEngine.h"
+#include "DeEssKernels.h"
+#include "MultichannelLinkwitzRiley.h"
+
+// Splits off the sibilant band with a Linkwitz-Riley crossover and gates it
+// with a hysteresis counter: a high-band sample above the threshold keeps the
+// band attenuated for the next hysteresis samples. No latency.
+//
+// With control-rate detection (see DeEssEngine::Detection) the gate decides
+// once per controlInterval samples instead, from the peak or RMS level of the
+// stretch just gone, and the band's gain glides linearly to the decision over
+// the next stretch. The gain then never jumps between two samples, so there is
+// no gate chatter on noisy sibilants, and RMS ignores single stray peaks. It
+// is not a big CPU saving here: the crossover costs more than either gate,
+// and the per-sample gate already skips whole vectors at a time. The costs:
+// attenuation starts up to one interval plus one glide late, so the leading
+// edge of an 's' gets through; hysteresis is rounded up to whole intervals;
+// and RMS reads lower than peak, so it needs a lower threshold for the same
+// material. 16 samples (0.3 ms at 48 kHz) is hard to tell from per-sample
+// detection, and 32 still catches short sibilants; beyond 64 the late onset
+// becomes audible on hard consonants. The benchmarks' engine cases compare
+// the modes' cost on a given machine.
+class AmplitudeThresholdEngine : public DeEssEngine
+{
+public:
+    AmplitudeThresholdEngine();
+
+    void prepare(double sampleRate, int maximumBlockSize, int numChannels) override;
+    void reset() override;
+    void setParameters(float thresholdDb, float mixDb, float frequency, int hysteresisSamples) override;
+    void setDetection(const Detection& newDetection) override;
+    void process(juce::AudioBuffer<float>& buffer, int startSample, int numSamples) override;
+    int getLatencySamples() const override  { return 0; }
+
+    // Parameter ramps are not included, so only hand states over while the
+    // parameters stay put
+    bool getState(State& state) const override;
+    bool setState(const State& newState) override;
+
+    // On by default. Off sends every layout through the generic path, which
+    // the fixed layouts must match bit for bit; takes effect at the next
+    // prepare().
+    void setUsesFixedLayouts(bool shouldUse) noexcept  { usesFixedLayouts = shouldUse; }
+
+private:
+    // Picked in prepare(). Mono and stereo, the layouts nearly every session
+    // uses, get copies with the channel count fixed at compile time, and at
+    // 64, 128 or 256 samples the block size too; everything else takes the
+    // generic path. All of them produce the same output.
+    using ProcessFunction = void (AmplitudeThresholdEngine::*)(juce::AudioBuffer<float>&, int, int);
+    static ProcessFunction chooseProcessFunction(int numChannels, int blockSize);
+
+    void processGeneric(juce::AudioBuffer<float>& buffer, int startSample, int numSamples);
+
+    // BlockSize 0 takes numSamples at run time
+    template <int NumChannels, int BlockSize>
+    void processFixedLayout(juce::AudioBuffer<float>& buffer, int startSample, int numSamples);
+
+    // Fills the per-sample ramps of the parameters that are moving; nullptr for the others
+    void renderRamps(int numSamples, const float*& thresholds, const float*& gains);
+
+    // Control-rate detection, any channel count
+    void processControlRate(juce::AudioBuffer<float>& buffer, int startSample, int numSamples);
+
+    // Starts control-rate detection from the per-sample gate's current state
+    void resetControlState();
+
+    ProcessFunction processFunction = &AmplitudeThresholdEngine::processGeneric;
+    bool usesFixedLayouts = true;
+
+    // Picked once by CPU feature detection when the engine is created
+    const DeEssKernels::KernelSet& kernels;
+
+    // Splits the input into the phase-aligned full band and the sibilant high
+    // band in one pass, several channels per instruction
+    MultichannelLinkwitzRiley crossover;
+
+    // Latest values from setParameters()
+    float targetThresholdDb = -20.0f;
+    float targetMixDb = 0.0f;
+    float targetFrequency = 6500.0f;
+
+    float currentFrequency { 6500.0f };
+    int hysteresisSamples = 100;
+    juce::SmoothedValue<float> thresholdGain { 0.1f };
+    juce::SmoothedValue<float> mixGain { 1.0f };
+    double currentSampleRate = 44100.0;
+    static constexpr double thresholdRampSeconds = 0.05;
+    static constexpr double mixRampSeconds = 0.02;
+
+    std::vector<int> hysteresisCounters;
+
+    // Control-rate detection. Per channel: the gain at the start of the
+    // current stretch, the gain it glides to, and the stretch's level so far;
+    // all channels share the position within the stretch.
+    Detection detection;
+    std::vector<float> controlGains;
+    std::vector<float> controlTargets;
+    std::vector<float> controlLevels;
+    int controlPosition = 0;
+    std::vector<float> gainCurve;
+
+    // Crossover outputs, sized in prepare() so the audio thread never allocates
+    juce::AudioBuffer<float> sibilantBuffer;
+    juce::AudioBuffer<float> originalBuffer;
+    std::vector<float> thresholdRamp;
+    std::vector<float> mixRamp;
+    int maxBlockSize = 0;
+    int numPreparedChannels = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(AmplitudeThresholdEngine)
+};
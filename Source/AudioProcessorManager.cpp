@@ -1,127 +1,289 @@
-/*
-  ==============================================================================
-
-    AudioProcessorManager.cpp
-    Created: 18 Nov 2024 12:07:09pm
-    Author:  Leif Rehtanz
-
-  ==============================================================================
-*/
-
-#include "AudioProcessorManager.h"
-
-AudioProcessorManager::AudioProcessorManager()
-{
-    highPassFilter.setType(juce::dsp::LinkwitzRileyFilterType::highpass);
-    highPassFilter.setCutoffFrequency(frequency);
-    
-    allPassFilter.setType(juce::dsp::LinkwitzRileyFilterType::allpass);
-}
-
-void AudioProcessorManager::prepare(double sampleRate, int samplesPerBlock, int numChannels)
-{
-    juce::dsp::ProcessSpec spec { sampleRate, static_cast<juce::uint32>(samplesPerBlock), static_cast<juce::uint32>(numChannels) };
-    highPassFilter.prepare(spec);
-    highPassFilter.reset();
-    
-    allPassFilter.prepare(spec);
-    allPassFilter.reset();
-}
-
-void AudioProcessorManager::setDeEssingParameters(float newThreshold, float newMixLevel, float newFrequency, float newHysteresis)
-{
-    threshold = newThreshold;
-    mixLevel = newMixLevel;
-    frequency = newFrequency;
-    hysteresisSamples = (int) newHysteresis;
-    highPassFilter.setCutoffFrequency(frequency);
-}
-
-void AudioProcessorManager::processBlock(juce::AudioBuffer<float>& buffer)
-{
-    applyDeEssing(buffer);
-}
-
-void AudioProcessorManager::applyDeEssing(juce::AudioBuffer<float>& buffer)
-{
-    // Create a buffer to store sibilants
-    juce::AudioBuffer<float> sibilantBuffer;
-    sibilantBuffer.makeCopyOf(buffer);
-    
-    juce::AudioBuffer<float> originalBuffer;
-    originalBuffer.makeCopyOf(buffer);
-    
-    // Apply high-pass filter to isolate sibilants
-    juce::dsp::AudioBlock<float> sibilantBlock(sibilantBuffer);
-    juce::dsp::ProcessContextReplacing<float> sibilantContext(sibilantBlock);
-    highPassFilter.process(sibilantContext);
-    
-    // Apply all-pass filter to the original buffer to align delays
-    juce::dsp::AudioBlock<float> originalBlock(originalBuffer);
-    juce::dsp::ProcessContextReplacing<float> originalContext(originalBlock);
-    allPassFilter.process(originalContext);
-    
-    buffer.clear();
-    
-    if (hysteresisCounters.size() != static_cast<size_t>(buffer.getNumChannels()))
-    {
-        hysteresisCounters.resize(buffer.getNumChannels(), 0);
-    }
-    
-    
-    // Process each channel for sibilant detection and removal
-    for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
-    {
-        auto* originalData = originalBuffer.getWritePointer(channel);
-        auto* sibilantData = sibilantBuffer.getWritePointer(channel);
-        
-        int& counter = hysteresisCounters[channel];
-        
-        for (int sample = 0; sample < buffer.getNumSamples(); ++sample)
-        {
-            //            // Detect sibilants above the threshold
-            //            if (std::abs(sibilantData[sample]) > juce::Decibels::decibelsToGain(threshold))
-            //            {
-            //                originalData[sample] -= sibilantData[sample]; // Subtract sibilant from original
-            //            }
-            //            else
-            //            {
-            //                sibilantData[sample] = 0.0f; // Zero out non-sibilant regions
-            //            }
-            // Check if the sample crosses the upper threshold
-            if (std::abs(sibilantData[sample]) > juce::Decibels::decibelsToGain(threshold))
-            {
-                counter = hysteresisSamples; // Reset the counter
-            }
-            
-            // If the counter is active, classify as sibilant
-            if (counter > 0)
-            {
-                --counter;
-                originalData[sample] -= sibilantData[sample]; // Subtract sibilant from original
-            }
-            else
-            {
-                sibilantData[sample] = 0.0f; // Zero out non-sibilant regions
-            }
-        }
-    }
-    
-    // Mix adjusted sibilants back into the original signal
-    float gainFactor = juce::Decibels::decibelsToGain(mixLevel);
-    //    DBG("Gain factor: " << gainFactor << " Mix level: " << mixLevel);
-    for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
-    {
-        auto* originalData = originalBuffer.getWritePointer(channel);
-        auto* sibilantData = sibilantBuffer.getWritePointer(channel);
-        
-        auto* finalData = buffer.getWritePointer(channel);
-        
-        for (int sample = 0; sample < buffer.getNumSamples(); ++sample)
-        {
-            finalData[sample] = originalData[sample]; // Copy original data
-            finalData[sample] += gainFactor * sibilantData[sample]; // Mix sibilants back
-        }
-    }
-}
-
+/*
+  ==============================================================================
+
+    AudioProcessorManager.cpp
+    Created: 18 Nov 2024 12:07:09pm
+    Author:  Leif Rehtanz
+
+  ==============================================================================
+*/
+
+#include "AudioProcessorManager.h"
+#include "RealtimeAllocationChecker.h"
+
+AudioProcessorManager::AudioProcessorManager()
+{
+    activeEngine = DeEssEngineRegistry::createEngine(requestedAlgorithm);
+}
+
+AudioProcessorManager::~AudioProcessorManager()
+{
+    delete pendingEngine.exchange(nullptr);
+    delete retiredEngine.exchange(nullptr);
+}
+
+void AudioProcessorManager::prepare(double sampleRate, int samplesPerBlock, int numChannels)
+{
+    maxBlockSize = juce::jmax(1, samplesPerBlock);
+    numPreparedChannels = juce::jmax(0, numChannels);
+    currentSampleRate = sampleRate;
+
+    // Audio is stopped, so any switch in flight simply completes here
+    if (auto* pending = pendingEngine.exchange(nullptr))
+        activeEngine.reset(pending);
+    else if (incomingEngine != nullptr)
+        activeEngine = std::move(incomingEngine);
+
+    incomingEngine.reset();
+    releaseRetiredEngine();
+
+    prepareEngine(*activeEngine);
+    int latency = activeEngine->getLatencySamples();
+
+    // Every engine is prepared just to learn its latency at this spec
+    if (alignsLatencies)
+    {
+        for (const auto& entry : DeEssEngineRegistry::getEntries())
+        {
+            auto engine = entry.create();
+            prepareEngine(*engine);
+            latency = juce::jmax(latency, engine->getLatencySamples());
+        }
+    }
+
+    latencySamples = latency;
+
+    for (auto& pad : latencyPads)
+        pad.prepare(numPreparedChannels, alignsLatencies ? latency : 0);
+
+    activePad = 0;
+    latencyPads[activePad].reset(getLatencyPadding(*activeEngine));
+
+    crossfadeBuffer.setSize(numPreparedChannels, maxBlockSize, false, true, false);
+    crossfadeLength = juce::jmax(1, juce::roundToInt(crossfadeSeconds * sampleRate));
+}
+
+void AudioProcessorManager::setDeEssingParameters(float newThreshold, float newMixLevel, float newFrequency, float newHysteresis)
+{
+    threshold.store(newThreshold);
+    mixLevel.store(newMixLevel);
+    frequency.store(newFrequency);
+    hysteresis.store((int) newHysteresis);
+}
+
+void AudioProcessorManager::setDetection(const DeEssEngine::Detection& newDetection)
+{
+    // Two stores, so the audio thread may see one block with the new mode
+    // and the old interval; both are valid
+    controlInterval.store(newDetection.controlInterval);
+    detectionMode.store(newDetection.mode);
+}
+
+DeEssEngine::Detection AudioProcessorManager::getDetection() const noexcept
+{
+    DeEssEngine::Detection result;
+    result.mode = detectionMode.load();
+    result.controlInterval = controlInterval.load();
+    return result;
+}
+
+void AudioProcessorManager::setAlgorithm(Algorithm newAlgorithm)
+{
+    releaseRetiredEngine();
+
+    if (newAlgorithm == requestedAlgorithm)
+        return;
+
+    auto engine = DeEssEngineRegistry::createEngine(newAlgorithm);
+
+    if (engine == nullptr)
+        return;
+
+    requestedAlgorithm = newAlgorithm;
+
+    // Before the first prepare() there is no spec yet; prepare() adopts it then
+    if (maxBlockSize > 0)
+    {
+        prepareEngine(*engine);
+
+        if (! alignsLatencies)
+            latencySamples = engine->getLatencySamples();
+    }
+
+    // A switch the audio thread hasn't started on yet is simply replaced
+    delete pendingEngine.exchange(engine.release());
+}
+
+void AudioProcessorManager::releaseRetiredEngine()
+{
+    delete retiredEngine.exchange(nullptr);
+}
+
+void AudioProcessorManager::pushParameters(DeEssEngine& engine) const
+{
+    engine.setParameters(threshold.load(), mixLevel.load(), frequency.load(), hysteresis.load());
+    engine.setDetection(getDetection());
+}
+
+void AudioProcessorManager::prepareEngine(DeEssEngine& engine) const
+{
+    pushParameters(engine);
+    engine.prepare(currentSampleRate, maxBlockSize, numPreparedChannels);
+}
+
+int AudioProcessorManager::getLatencyPadding(const DeEssEngine& engine) const noexcept
+{
+    return alignsLatencies ? juce::jmax(0, latencySamples.load() - engine.getLatencySamples()) : 0;
+}
+
+void AudioProcessorManager::processBlock(juce::AudioBuffer<float>& buffer)
+{
+    RealtimeAllocationChecker::ScopedRealtimeSection realtimeSection;
+
+    // Not prepared yet: leave the audio untouched rather than resize on this thread
+    jassert(maxBlockSize > 0);
+    if (maxBlockSize <= 0 || numPreparedChannels == 0)
+        return;
+
+    const int numSamples = buffer.getNumSamples();
+
+    if (auto* fifo = spectrumFifo.load())
+        fifo->push(buffer, numPreparedChannels, 0, numSamples);
+
+    beginPendingSwitch();
+
+    for (int startSample = 0; startSample < numSamples; startSample += maxBlockSize)
+        applyDeEssing(buffer, startSample, juce::jmin(maxBlockSize, numSamples - startSample));
+}
+
+void AudioProcessorManager::beginPendingSwitch()
+{
+    // One switch at a time, and only once the last engine switched away from
+    // has been collected, so the retired slot is free when this one finishes
+    if (incomingEngine != nullptr || retiredEngine.load() != nullptr)
+        return;
+
+    if (auto* next = pendingEngine.exchange(nullptr))
+    {
+        incomingEngine.reset(next);
+        latencyPads[1 - activePad].reset(getLatencyPadding(*next));
+        warmUpRemaining = next->getLatencySamples() + getLatencyPadding(*next);
+        crossfadePosition = 0;
+    }
+}
+
+AudioProcessorManager::State AudioProcessorManager::getState() const
+{
+    jassert(incomingEngine == nullptr);
+
+    State state;
+    const bool supported = activeEngine->getState(state);
+    jassertquiet(supported);
+    return state;
+}
+
+void AudioProcessorManager::setState(const State& newState)
+{
+    jassert(incomingEngine == nullptr);
+
+    const bool supported = activeEngine->setState(newState);
+    jassertquiet(supported);
+}
+
+void AudioProcessorManager::applyDeEssing(juce::AudioBuffer<float>& buffer, int startSample, int numSamples)
+{
+    pushParameters(*activeEngine);
+
+    const int numChannels = juce::jmin(buffer.getNumChannels(), numPreparedChannels);
+
+    if (incomingEngine == nullptr)
+    {
+        activeEngine->process(buffer, startSample, numSamples);
+        latencyPads[activePad].process(buffer, startSample, numSamples, numChannels);
+        return;
+    }
+
+    // Both engines see the same input; the incoming one writes to the side buffer
+    for (int channel = 0; channel < numChannels; ++channel)
+        crossfadeBuffer.copyFrom(channel, 0, buffer, channel, startSample, numSamples);
+
+    pushParameters(*incomingEngine);
+    incomingEngine->process(crossfadeBuffer, 0, numSamples);
+    latencyPads[1 - activePad].process(crossfadeBuffer, 0, numSamples, numChannels);
+    activeEngine->process(buffer, startSample, numSamples);
+    latencyPads[activePad].process(buffer, startSample, numSamples, numChannels);
+
+    // Until its padded latency has passed, the incoming engine only puts out
+    // the silence it started from
+    if (warmUpRemaining > 0)
+    {
+        warmUpRemaining -= numSamples;
+        return;
+    }
+
+    for (int channel = 0; channel < numChannels; ++channel)
+    {
+        auto* out = buffer.getWritePointer(channel, startSample);
+        const auto* in = crossfadeBuffer.getReadPointer(channel);
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            const auto gain = juce::jmin(1.0f, (float) (crossfadePosition + i) / (float) crossfadeLength);
+            out[i] += gain * (in[i] - out[i]);
+        }
+    }
+
+    crossfadePosition += numSamples;
+
+    // Parked for the message thread; deleting it here could take a lock
+    if (crossfadePosition >= crossfadeLength)
+    {
+        retiredEngine.store(activeEngine.release());
+        activeEngine = std::move(incomingEngine);
+        activePad = 1 - activePad;
+    }
+}
+
+//==============================================================================
+void AudioProcessorManager::LatencyPad::prepare(int numChannels, int maxDelay)
+{
+    ring.setSize(numChannels, juce::jmax(1, maxDelay), false, true, false);
+    reset(0);
+}
+
+void AudioProcessorManager::LatencyPad::reset(int newDelay) noexcept
+{
+    jassert(newDelay == 0 || newDelay <= ring.getNumSamples());
+    delay = juce::jmin(newDelay, ring.getNumSamples());
+    position = 0;
+    ring.clear();
+}
+
+void AudioProcessorManager::LatencyPad::process(juce::AudioBuffer<float>& audio, int startSample,
+                                                int numSamples, int numChannels) noexcept
+{
+    if (delay == 0)
+        return;
+
+    // Each sample goes into the ring and the one written delay samples ago
+    // comes out, so a swap does both
+    int newPosition = position;
+
+    for (int channel = 0; channel < juce::jmin(numChannels, ring.getNumChannels()); ++channel)
+    {
+        auto* samples = audio.getWritePointer(channel, startSample);
+        auto* delayed = ring.getWritePointer(channel);
+        int done = 0;
+        newPosition = position;
+
+        while (done < numSamples)
+        {
+            const int length = juce::jmin(numSamples - done, delay - newPosition);
+            std::swap_ranges(samples + done, samples + done + length, delayed + newPosition);
+            done += length;
+            newPosition = (newPosition + length) % delay;
+        }
+    }
+
+    position = newPosition;
+}
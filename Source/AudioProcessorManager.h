@@ -1,38 +1,151 @@
-/*
-  ==============================================================================
-
-    AudioProcessorManager.h
-    Created: 18 Nov 2024 12:07:30pm
-    Author:  Leif Rehtanz
-
-  ==============================================================================
-*/
-
-#pragma once
-
-#include <JuceHeader.h>
-#include <functional>
-
-class AudioProcessorManager
-{
-public:
-    AudioProcessorManager();
-    ~AudioProcessorManager() = default;
-
-    void prepare(double sampleRate, int samplesPerBlock, int numChannels);
-    void setDeEssingParameters(float newThreshold, float newReduction, float newFrequency, float newHysteresis);
-    void processBlock(juce::AudioBuffer<float>& buffer);
-
-private:
-    juce::dsp::LinkwitzRileyFilter<float> highPassFilter;
-    juce::dsp::LinkwitzRileyFilter<float> allPassFilter;
-    
-    float threshold { -20.0f };
-    float mixLevel { 0.0f };
-    float frequency { 6500.0f };
-    int hysteresisSamples = 100;
-    std::vector<int> hysteresisCounters;
-
-    void applyDeEssing(juce::AudioBuffer<float>& buffer);
-};
- 
+/*
+  ==============================================================================
+
+    AudioProcessorManager.h
+    Created: 18 Nov 2024 12:07:30pm
+    Author:  Leif Rehtanz
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <functional>
+#include "DeEssEngineRegistry.h"
+#include "SpectrumFifo.h"
+
+// Runs the selected DeEssEngine on the audio thread. Switching algorithms
+// never touches the engine the audio thread is using: the new engine is
+// created and prepared on the message thread and published through an
+// atomic pointer; the audio thread takes it with one exchange at a block
+// boundary, runs it silently until its latency has passed, crossfades from
+// the old engine to it, and parks the old engine for the message thread to
+// delete. Every engine's output is delayed to the latency of the slowest
+// registered one, so both sides of the crossfade line up and a switch never
+// moves the audio in time.
+class AudioProcessorManager
+{
+public:
+    using Algorithm = DeEssEngineRegistry::Algorithm;
+
+    AudioProcessorManager();
+    ~AudioProcessorManager();
+
+    // Allocates all scratch storage; must be called before processBlock() and
+    // whenever the sample rate, maximum block size or channel count changes.
+    void prepare(double sampleRate, int samplesPerBlock, int numChannels);
+
+    // Safe to call from any thread while audio is running: the values are
+    // published through atomics and picked up by the audio thread at the
+    // start of the next block.
+    void setDeEssingParameters(float newThreshold, float newReduction, float newFrequency, float newHysteresis);
+
+    // Per-sample or control-rate gating (see AmplitudeThresholdEngine); any
+    // thread, picked up like the parameters. Algorithms without a
+    // sample-domain gate ignore it.
+    void setDetection(const DeEssEngine::Detection& newDetection);
+    DeEssEngine::Detection getDetection() const noexcept;
+
+    // Message thread. Creates and prepares the new engine here; the audio
+    // thread crossfades to it over the next few blocks.
+    void setAlgorithm(Algorithm newAlgorithm);
+    Algorithm getAlgorithm() const noexcept  { return requestedAlgorithm; }
+
+    // Output delay in samples, valid after prepare(). The same for every
+    // algorithm while latencies are aligned.
+    int getLatencySamples() const noexcept  { return latencySamples.load(); }
+
+    // On by default. Offline renders never switch algorithms, so they turn it
+    // off to skip the padding delay; takes effect at the next prepare().
+    void setAlignsLatencies(bool shouldAlign) noexcept  { alignsLatencies = shouldAlign; }
+
+    // Deletes an engine the audio thread has switched away from. Message
+    // thread; call it now and then (setAlgorithm() does too), since the next
+    // switch waits until the previous engine has been collected.
+    void releaseRetiredEngine();
+
+    // Every block's input is pushed into this FIFO, unprocessed, for the
+    // spectrum display; nullptr turns that off. The FIFO must outlive audio
+    // processing or be detached first.
+    void setSpectrumFifo(SpectrumFifo* newFifo) noexcept  { spectrumFifo.store(newFifo); }
+
+    // Real-time safe: never allocates, locks or frees. Buffers longer than the
+    // prepared block size are processed in prepared-size slices, and channels
+    // beyond the prepared channel count are passed through untouched.
+    void processBlock(juce::AudioBuffer<float>& buffer);
+
+    // Everything the processor carries from one block into the next. Two
+    // managers prepared with the same settings and given equal states produce
+    // bit-identical output for the same input, which lets a long render be
+    // split between several managers. Covers the amplitude threshold
+    // algorithm only. Parameter ramps are not included, so
+    // only hand states over while the parameters stay put. These allocate;
+    // don't call them on the audio thread, or during a switch.
+    using State = DeEssEngine::State;
+
+    State getState() const;
+    void setState(const State& newState);
+
+private:
+    static constexpr double crossfadeSeconds = 0.02;
+
+    // Prepares an engine for the current spec with the latest parameters
+    void prepareEngine(DeEssEngine& engine) const;
+    void pushParameters(DeEssEngine& engine) const;
+    void beginPendingSwitch();
+    void applyDeEssing(juce::AudioBuffer<float>& buffer, int startSample, int numSamples);
+    int getLatencyPadding(const DeEssEngine& engine) const noexcept;
+
+    // Delays an engine's output up to the common latency. A ring of delay
+    // samples per channel, swapped with the audio a stretch at a time;
+    // sized in prepare(), so reset() and process() never allocate.
+    class LatencyPad
+    {
+    public:
+        void prepare(int numChannels, int maxDelay);
+        void reset(int newDelay) noexcept;
+        void process(juce::AudioBuffer<float>& audio, int startSample, int numSamples, int numChannels) noexcept;
+
+    private:
+        juce::AudioBuffer<float> ring;
+        int delay = 0;
+        int position = 0;
+    };
+
+    // Audio thread only, apart from prepare()
+    std::unique_ptr<DeEssEngine> activeEngine;
+    std::unique_ptr<DeEssEngine> incomingEngine;
+    int warmUpRemaining = 0;
+    int crossfadePosition = 0;
+    int crossfadeLength = 1;
+    LatencyPad latencyPads[2];  // Indexed by activePad for the active engine
+    int activePad = 0;
+
+    // Handed between the threads; each holds at most one engine, owned by
+    // whoever takes it out with an exchange
+    std::atomic<DeEssEngine*> pendingEngine { nullptr };
+    std::atomic<DeEssEngine*> retiredEngine { nullptr };
+
+    Algorithm requestedAlgorithm = Algorithm::amplitudeThreshold;
+    std::atomic<int> latencySamples { 0 };
+    bool alignsLatencies = true;
+
+    std::atomic<SpectrumFifo*> spectrumFifo { nullptr };
+    
+    // Written by setDeEssingParameters(), read once per block by the audio thread
+    std::atomic<float> threshold { -20.0f };
+    std::atomic<float> mixLevel { 0.0f };
+    std::atomic<float> frequency { 6500.0f };
+    std::atomic<int> hysteresis { 100 };
+    std::atomic<DeEssEngine::Detection::Mode> detectionMode { DeEssEngine::Detection::Mode::perSample };
+    std::atomic<int> controlInterval { 16 };
+
+    // The incoming engine's output while crossfading, sized in prepare()
+    juce::AudioBuffer<float> crossfadeBuffer;
+    double currentSampleRate = 0.0;
+    int maxBlockSize = 0;
+    int numPreparedChannels = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(AudioProcessorManager)
+};
@@ -0,0 +1,130 @@
+/*
+  ==============================================================================
+
+    BandPeakPyramid.cpp
+    Created: 18 Oct 2026 1:12:06am
+    Author:  Leif Rehtanz
+
+  ==============================================================================
+*/
+
+#include "BandPeakPyramid.h"
+
+BandPeakPyramid::BandPeakPyramid(std::vector<float> blockPeaks, juce::int64 lengthInSamplesToUse, float frequencyToUse)
+    : lengthInSamples(lengthInSamplesToUse),
+      numBlocks((juce::int64) blockPeaks.size()),
+      frequency(frequencyToUse)
+{
+    jassert(numBlocks == (lengthInSamples + samplesPerBlock - 1) / samplesPerBlock);
+
+    minima.push_back(blockPeaks);
+    maxima.push_back(std::move(blockPeaks));
+
+    while (maxima.back().size() > 1)
+    {
+        const auto& finerMaxima = maxima.back();
+        const auto& finerMinima = minima.back();
+        const auto size = (finerMaxima.size() + branchingFactor - 1) / branchingFactor;
+
+        std::vector<float> levelMaxima(size), levelMinima(size);
+
+        for (size_t node = 0; node < size; ++node)
+        {
+            const auto first = node * branchingFactor;
+            const auto last = juce::jmin(first + branchingFactor, finerMaxima.size());
+
+            levelMaxima[node] = *std::max_element(finerMaxima.begin() + (std::ptrdiff_t) first, finerMaxima.begin() + (std::ptrdiff_t) last);
+            levelMinima[node] = *std::min_element(finerMinima.begin() + (std::ptrdiff_t) first, finerMinima.begin() + (std::ptrdiff_t) last);
+        }
+
+        maxima.push_back(std::move(levelMaxima));
+        minima.push_back(std::move(levelMinima));
+    }
+}
+
+juce::int64 BandPeakPyramid::getBlocksPerNode(int level) const noexcept
+{
+    juce::int64 blocks = 1;
+
+    for (int i = 0; i < level; ++i)
+        blocks *= branchingFactor;
+
+    return blocks;
+}
+
+juce::int64 BandPeakPyramid::getSamplesInBlocks(juce::int64 firstBlock, juce::int64 lastBlock) const noexcept
+{
+    // Only the file's last block can be short
+    return juce::jmin(lastBlock * samplesPerBlock, lengthInSamples) - firstBlock * samplesPerBlock;
+}
+
+juce::int64 BandPeakPyramid::countFlaggedSamples(juce::int64 startSample, juce::int64 endSample, float threshold) const
+{
+    startSample = juce::jlimit((juce::int64) 0, lengthInSamples, startSample);
+    endSample = juce::jlimit(startSample, lengthInSamples, endSample);
+
+    if (startSample == endSample || numBlocks == 0)
+        return 0;
+
+    const auto& peaks = maxima.front();
+
+    // Blocks wholly inside the range go through the pyramid; the ones cut by
+    // either end of it are checked directly
+    const auto firstWholeBlock = (startSample + samplesPerBlock - 1) / samplesPerBlock;
+    const auto lastWholeBlock = endSample == lengthInSamples ? numBlocks : endSample / samplesPerBlock;
+
+    if (firstWholeBlock >= lastWholeBlock)
+    {
+        juce::int64 flagged = 0;
+
+        for (auto block = startSample / samplesPerBlock; block * samplesPerBlock < endSample; ++block)
+        {
+            if (peaks[(size_t) block] > threshold)
+                flagged += juce::jmin(endSample, (block + 1) * samplesPerBlock) - juce::jmax(startSample, block * samplesPerBlock);
+        }
+
+        return flagged;
+    }
+
+    juce::int64 flagged = 0;
+
+    if (startSample < firstWholeBlock * samplesPerBlock && peaks[(size_t) firstWholeBlock - 1] > threshold)
+        flagged += firstWholeBlock * samplesPerBlock - startSample;
+
+    if (lastWholeBlock < numBlocks && endSample > lastWholeBlock * samplesPerBlock && peaks[(size_t) lastWholeBlock] > threshold)
+        flagged += endSample - lastWholeBlock * samplesPerBlock;
+
+    const int topLevel = (int) maxima.size() - 1;
+    return flagged + countFlaggedBlocks(topLevel, 0, firstWholeBlock, lastWholeBlock, threshold);
+}
+
+juce::int64 BandPeakPyramid::countFlaggedBlocks(int level, juce::int64 node, juce::int64 firstBlock,
+                                                juce::int64 lastBlock, float threshold) const
+{
+    const auto blocksPerNode = getBlocksPerNode(level);
+    const auto nodeFirst = node * blocksPerNode;
+    const auto nodeLast = juce::jmin(nodeFirst + blocksPerNode, numBlocks);
+
+    if (nodeLast <= firstBlock || nodeFirst >= lastBlock || maxima[(size_t) level][(size_t) node] <= threshold)
+        return 0;
+
+    // Every block under a node whose quietest peak is above the threshold is flagged
+    if (nodeFirst >= firstBlock && nodeLast <= lastBlock && minima[(size_t) level][(size_t) node] > threshold)
+        return getSamplesInBlocks(nodeFirst, nodeLast);
+
+    if (level == 0)
+        return getSamplesInBlocks(nodeFirst, nodeLast);
+
+    juce::int64 flagged = 0;
+    const auto finerSize = (juce::int64) maxima[(size_t) level - 1].size();
+
+    for (auto child = node * branchingFactor; child < juce::jmin(finerSize, (node + 1) * branchingFactor); ++child)
+        flagged += countFlaggedBlocks(level - 1, child, firstBlock, lastBlock, threshold);
+
+    return flagged;
+}
+
+double BandPeakPyramid::getFlaggedFraction(float threshold) const
+{
+    return lengthInSamples > 0 ? (double) countFlaggedSamples(0, lengthInSamples, threshold) / (double) lengthInSamples : 0.0;
+}
@@ -0,0 +1,56 @@
+/*
+  ==============================================================================
+
+    BandPeakPyramid.h
+    Created: 18 Oct 2026 1:12:06am
+    Author:  Leif Rehtanz
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+// Peak envelope of the sibilant band of a whole file, for one crossover
+// frequency: the loudest high-band sample of each block of samplesPerBlock
+// samples, with levels of branchingFactor times coarser maxima and minima of
+// those peaks on top. A threshold question only descends into nodes whose
+// peaks straddle the threshold, so it costs about the number of threshold
+// crossings in the range rather than its length, which is what lets the
+// threshold slider preview its effect while it is being dragged.
+//
+// Flagging is per block: a block counts as sibilant if its peak is above the
+// threshold. That ignores the gate's hysteresis and is at most a block out
+// at each region edge, which is plenty for a preview.
+class BandPeakPyramid
+{
+public:
+    static constexpr int samplesPerBlock = 64;
+    static constexpr int branchingFactor = 8;
+
+    BandPeakPyramid(std::vector<float> blockPeaks, juce::int64 lengthInSamples, float frequency);
+
+    float getFrequency() const noexcept              { return frequency; }
+    juce::int64 getLengthInSamples() const noexcept  { return lengthInSamples; }
+
+    // Samples in [startSample, endSample) lying in blocks whose peak is
+    // above threshold (linear gain)
+    juce::int64 countFlaggedSamples(juce::int64 startSample, juce::int64 endSample, float threshold) const;
+
+    // Share of the whole file flagged at threshold
+    double getFlaggedFraction(float threshold) const;
+
+private:
+    juce::int64 countFlaggedBlocks(int level, juce::int64 node, juce::int64 firstBlock, juce::int64 lastBlock, float threshold) const;
+    juce::int64 getSamplesInBlocks(juce::int64 firstBlock, juce::int64 lastBlock) const noexcept;
+    juce::int64 getBlocksPerNode(int level) const noexcept;
+
+    // Level 0 holds the block peaks themselves, the last level a single node
+    std::vector<std::vector<float>> maxima, minima;
+    const juce::int64 lengthInSamples;
+    const juce::int64 numBlocks;
+    const float frequency;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(BandPeakPyramid)
+};
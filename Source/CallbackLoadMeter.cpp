@@ -0,0 +1,176 @@
+/*
+  ==============================================================================
+
+    CallbackLoadMeter.cpp
+    Created: 17 Oct 2026 10:31:40pm
+    Author:  Leif Rehtanz
+
+  ==============================================================================
+*/
+
+#include "CallbackLoadMeter.h"
+
+namespace
+{
+    juce::Colour getLoadColour(double load)
+    {
+        if (load > 1.0)
+            return juce::Colours::red;
+
+        return load > 0.7 ? juce::Colours::orange : juce::Colours::lightgreen;
+    }
+}
+
+CallbackLoadMeter::CallbackLoadMeter(CallbackLoadMonitor& monitorToShow, juce::AudioDeviceManager& deviceManagerToUse)
+    : monitor(monitorToShow),
+      deviceManager(deviceManagerToUse)
+{
+    resetButton.onClick = [this] { monitor.reset(); };
+    saveButton.onClick = [this] { saveReport(); };
+
+    addAndMakeVisible(resetButton);
+    addAndMakeVisible(saveButton);
+
+    startTimerHz(10);
+}
+
+int CallbackLoadMeter::getDeviceXRunCount() const
+{
+    // -1 when the driver doesn't report xruns
+    auto* device = deviceManager.getCurrentAudioDevice();
+    return device != nullptr ? device->getXRunCount() : -1;
+}
+
+void CallbackLoadMeter::timerCallback()
+{
+    const auto newStats = monitor.getStats();
+    const auto newXRuns = getDeviceXRunCount();
+
+    if (newStats.numCallbacks == stats.numCallbacks && newXRuns == deviceXRuns)
+    {
+        // Stopped: nothing ran, so nothing is loaded
+        if (currentLoad != 0.0)
+        {
+            currentLoad = 0.0;
+            repaint();
+        }
+
+        return;
+    }
+
+    // Load since the last tick from the running totals; after a reset they
+    // start again from zero, and the latest callback stands in
+    const auto budget = newStats.budgetSeconds - stats.budgetSeconds;
+    currentLoad = budget > 0.0 ? (newStats.busySeconds - stats.busySeconds) / budget : newStats.lastLoad;
+
+    stats = newStats;
+    deviceXRuns = newXRuns;
+    repaint();
+}
+
+void CallbackLoadMeter::resized()
+{
+    auto buttonRow = getLocalBounds().reduced(4).removeFromTop(rowHeight);
+    saveButton.setBounds(buttonRow.removeFromRight(110));
+    buttonRow.removeFromRight(4);
+    resetButton.setBounds(buttonRow.removeFromRight(60));
+}
+
+void CallbackLoadMeter::paint(juce::Graphics& g)
+{
+    g.fillAll(juce::Colours::black);
+
+    auto area = getLocalBounds().reduced(4);
+    auto textRow = area.removeFromTop(rowHeight).withTrimmedRight(180);
+
+    juce::String text;
+    text << "DSP load " << juce::String(currentLoad * 100.0, 1) << "% (peak "
+         << juce::String(stats.peakLoad * 100.0, 1) << "%)   overruns " << (juce::int64) stats.numOverruns
+         << "   xruns " << (deviceXRuns >= 0 ? juce::String(deviceXRuns) : juce::String("n/a"));
+
+    g.setColour(juce::Colours::white);
+    g.setFont(13.0f);
+    g.drawFittedText(text, textRow, juce::Justification::centredLeft, 1);
+
+    // Load bar, full width at 100%, with a tick at the peak
+    area.removeFromTop(4);
+    auto bar = area.removeFromTop(8).toFloat();
+
+    g.setColour(juce::Colours::darkgrey);
+    g.fillRect(bar);
+    g.setColour(getLoadColour(currentLoad));
+    g.fillRect(bar.withWidth(bar.getWidth() * (float) juce::jmin(1.0, currentLoad)));
+    g.setColour(juce::Colours::white);
+    g.fillRect(bar.getX() + bar.getWidth() * (float) juce::jmin(1.0, stats.peakLoad) - 1.0f, bar.getY(), 2.0f, bar.getHeight());
+
+    // Histogram of callback times; log heights, so rare slow callbacks still show
+    area.removeFromTop(6);
+    auto plot = area.toFloat();
+
+    if (plot.getHeight() < 8.0f)
+        return;
+
+    juce::uint64 maxCount = 0;
+
+    for (auto count : stats.histogram)
+        maxCount = juce::jmax(maxCount, count);
+
+    const auto binWidth = plot.getWidth() / (float) CallbackLoadMonitor::numHistogramBins;
+    const auto logMax = std::log1p((double) maxCount);
+
+    for (int bin = 0; bin < CallbackLoadMonitor::numHistogramBins; ++bin)
+    {
+        const auto count = stats.histogram[(size_t) bin];
+
+        if (count == 0)
+            continue;
+
+        const auto height = plot.getHeight() * (float) (std::log1p((double) count) / logMax);
+        g.setColour(getLoadColour((bin + 0.5) * CallbackLoadMonitor::histogramBinWidth));
+        g.fillRect(plot.getX() + bin * binWidth + 1.0f, plot.getBottom() - height, binWidth - 2.0f, height);
+    }
+
+    // The deadline
+    const auto deadlineX = plot.getX() + binWidth * (float) (1.0 / CallbackLoadMonitor::histogramBinWidth);
+    g.setColour(juce::Colours::red.withAlpha(0.7f));
+    g.drawVerticalLine(juce::roundToInt(deadlineX), plot.getY(), plot.getBottom());
+}
+
+juce::String CallbackLoadMeter::createReport() const
+{
+    auto report = monitor.getStats().toString();
+
+    if (auto* device = deviceManager.getCurrentAudioDevice())
+    {
+        report << "\nDevice: " << device->getName() << " (" << device->getTypeName() << ")\n"
+               << "Buffer size: " << device->getCurrentBufferSizeSamples() << " samples, output latency: "
+               << device->getOutputLatencyInSamples() << " samples\n"
+               << "Device xruns: " << (getDeviceXRunCount() >= 0 ? juce::String(getDeviceXRunCount())
+                                                                 : juce::String("not reported by this driver")) << "\n";
+    }
+
+    return report;
+}
+
+void CallbackLoadMeter::saveReport()
+{
+    const auto report = createReport();
+
+    chooser = std::make_unique<juce::FileChooser>("Save the callback load report...",
+                                                  juce::File::getSpecialLocation(juce::File::userDocumentsDirectory)
+                                                      .getChildFile("CallbackLoad.txt"),
+                                                  "*.txt");
+
+    const auto chooserFlags = juce::FileBrowserComponent::saveMode
+                            | juce::FileBrowserComponent::canSelectFiles
+                            | juce::FileBrowserComponent::warnAboutOverwriting;
+
+    chooser->launchAsync(chooserFlags, [report] (const juce::FileChooser& fc)
+    {
+        const auto file = fc.getResult();
+
+        if (file != juce::File{} && ! file.replaceWithText(report))
+            juce::AlertWindow::showMessageBoxAsync(juce::MessageBoxIconType::WarningIcon, "Save Report",
+                                                   "Could not write " + file.getFullPathName());
+    });
+}
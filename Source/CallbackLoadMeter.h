@@ -0,0 +1,49 @@
+/*
+  ==============================================================================
+
+    CallbackLoadMeter.h
+    Created: 17 Oct 2026 10:31:40pm
+    Author:  Leif Rehtanz
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "CallbackLoadMonitor.h"
+
+// Shows how close the audio callback runs to its deadline: the load over the
+// last tenth of a second and its peak, a histogram of callback times as a
+// share of their budget, and the overrun and device xrun counts. The report
+// can be saved as text to compare buffer settings on a machine.
+class CallbackLoadMeter : public juce::Component,
+                          private juce::Timer
+{
+public:
+    CallbackLoadMeter(CallbackLoadMonitor& monitorToShow, juce::AudioDeviceManager& deviceManagerToUse);
+
+    void paint(juce::Graphics& g) override;
+    void resized() override;
+
+private:
+    static constexpr int rowHeight = 22;
+
+    void timerCallback() override;
+    void saveReport();
+    juce::String createReport() const;
+    int getDeviceXRunCount() const;
+
+    CallbackLoadMonitor& monitor;
+    juce::AudioDeviceManager& deviceManager;
+
+    CallbackLoadMonitor::Stats stats;
+    double currentLoad = 0.0;
+    int deviceXRuns = -1;
+
+    juce::TextButton resetButton { "Reset" };
+    juce::TextButton saveButton { "Save Report..." };
+    std::unique_ptr<juce::FileChooser> chooser;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(CallbackLoadMeter)
+};
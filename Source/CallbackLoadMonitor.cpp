@@ -0,0 +1,121 @@
+/*
+  ==============================================================================
+
+    CallbackLoadMonitor.cpp
+    Created: 17 Oct 2026 10:05:12pm
+    Author:  Leif Rehtanz
+
+  ==============================================================================
+*/
+
+#include "CallbackLoadMonitor.h"
+
+CallbackLoadMonitor::CallbackLoadMonitor()
+{
+    secondsPerTick.store(1.0 / (double) juce::Time::getHighResolutionTicksPerSecond());
+}
+
+void CallbackLoadMonitor::prepare(double newSampleRate, int newExpectedBlockSize)
+{
+    sampleRate.store(newSampleRate);
+    expectedBlockSize.store(newExpectedBlockSize);
+
+    // Figures from other settings would only muddy these
+    clear();
+    resetRequested.store(false);
+}
+
+void CallbackLoadMonitor::addCallback(int numSamples, juce::int64 elapsedTicks) noexcept
+{
+    if (resetRequested.exchange(false))
+        clear();
+
+    const auto rate = sampleRate.load(std::memory_order_relaxed);
+
+    if (rate <= 0.0 || numSamples <= 0)
+        return;
+
+    const auto elapsed = (double) elapsedTicks * secondsPerTick.load(std::memory_order_relaxed);
+    const auto budget = numSamples / rate;
+    const auto load = elapsed / budget;
+
+    increment(numCallbacks);
+
+    if (load > 1.0)
+        increment(numOverruns);
+
+    lastLoad.store(load, std::memory_order_relaxed);
+
+    if (load > peakLoad.load(std::memory_order_relaxed))
+        peakLoad.store(load, std::memory_order_relaxed);
+
+    if (elapsed > worstCallbackSeconds.load(std::memory_order_relaxed))
+        worstCallbackSeconds.store(elapsed, std::memory_order_relaxed);
+
+    busySeconds.store(busySeconds.load(std::memory_order_relaxed) + elapsed, std::memory_order_relaxed);
+    budgetSeconds.store(budgetSeconds.load(std::memory_order_relaxed) + budget, std::memory_order_relaxed);
+
+    const auto bin = juce::jlimit(0, numHistogramBins - 1, (int) (load / histogramBinWidth));
+    increment(histogram[(size_t) bin]);
+}
+
+void CallbackLoadMonitor::clear() noexcept
+{
+    numCallbacks.store(0);
+    numOverruns.store(0);
+    lastLoad.store(0.0);
+    peakLoad.store(0.0);
+    worstCallbackSeconds.store(0.0);
+    busySeconds.store(0.0);
+    budgetSeconds.store(0.0);
+
+    for (auto& count : histogram)
+        count.store(0);
+}
+
+CallbackLoadMonitor::Stats CallbackLoadMonitor::getStats() const
+{
+    Stats stats;
+    stats.sampleRate = sampleRate.load();
+    stats.expectedBlockSize = expectedBlockSize.load();
+    stats.numCallbacks = numCallbacks.load();
+    stats.numOverruns = numOverruns.load();
+    stats.lastLoad = lastLoad.load();
+    stats.peakLoad = peakLoad.load();
+    stats.worstCallbackSeconds = worstCallbackSeconds.load();
+    stats.busySeconds = busySeconds.load();
+    stats.budgetSeconds = budgetSeconds.load();
+
+    for (size_t i = 0; i < histogram.size(); ++i)
+        stats.histogram[i] = histogram[i].load();
+
+    return stats;
+}
+
+juce::String CallbackLoadMonitor::Stats::toString() const
+{
+    const auto percent = [] (double load) { return juce::String(load * 100.0, 1) + "%"; };
+    const auto blockBudgetMs = sampleRate > 0.0 ? 1000.0 * expectedBlockSize / sampleRate : 0.0;
+
+    juce::String text;
+    text << "Audio callback load\n"
+         << "Sample rate: " << juce::String(sampleRate, 0) << " Hz, block size: " << expectedBlockSize
+         << " samples (" << juce::String(blockBudgetMs, 2) << " ms per block)\n"
+         << "Callbacks: " << (juce::int64) numCallbacks << ", overruns: " << (juce::int64) numOverruns
+         << " (" << percent(numCallbacks > 0 ? (double) numOverruns / (double) numCallbacks : 0.0) << ")\n"
+         << "Average load: " << percent(getAverageLoad()) << ", peak load: " << percent(peakLoad)
+         << ", slowest callback: " << juce::String(worstCallbackSeconds * 1000.0, 3) << " ms\n"
+         << "\nShare of budget used    Callbacks\n";
+
+    for (int bin = 0; bin < numHistogramBins; ++bin)
+    {
+        const auto low = juce::String(juce::roundToInt(bin * histogramBinWidth * 100.0));
+        const auto range = bin < numHistogramBins - 1
+                         ? low + "-" + juce::String(juce::roundToInt((bin + 1) * histogramBinWidth * 100.0)) + "%"
+                         : low + "% and over";
+
+        text << range.paddedRight(' ', 24) << (juce::int64) histogram[(size_t) bin] << "\n";
+    }
+
+    return text;
+}
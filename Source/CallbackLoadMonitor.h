@@ -0,0 +1,112 @@
+/*
+  ==============================================================================
+
+    CallbackLoadMonitor.h
+    Created: 17 Oct 2026 10:05:12pm
+    Author:  Leif Rehtanz
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <array>
+
+// Times every audio callback against its deadline, the duration of the audio
+// it delivers. The audio thread is the only writer and only stores to atomics,
+// so recording is wait-free; any other thread can take a snapshot at any time.
+class CallbackLoadMonitor
+{
+public:
+    // Callback time as a share of its budget, in 5% steps; the last bin also
+    // takes everything slower
+    static constexpr int numHistogramBins = 30;
+    static constexpr double histogramBinWidth = 0.05;
+
+    CallbackLoadMonitor();
+
+    // Call before audio starts, with the device settings, from prepareToPlay()
+    void prepare(double sampleRate, int expectedBlockSize);
+
+    // Measures the audio callback from construction to destruction
+    class ScopedCallback
+    {
+    public:
+        ScopedCallback(CallbackLoadMonitor& monitorToUse, int numSamplesToDeliver) noexcept
+            : monitor(monitorToUse), numSamples(numSamplesToDeliver), startTicks(juce::Time::getHighResolutionTicks())
+        {
+        }
+
+        ~ScopedCallback() noexcept
+        {
+            monitor.addCallback(numSamples, juce::Time::getHighResolutionTicks() - startTicks);
+        }
+
+    private:
+        CallbackLoadMonitor& monitor;
+        const int numSamples;
+        const juce::int64 startTicks;
+
+        JUCE_DECLARE_NON_COPYABLE(ScopedCallback)
+    };
+
+    struct Stats
+    {
+        double getAverageLoad() const noexcept  { return budgetSeconds > 0.0 ? busySeconds / budgetSeconds : 0.0; }
+
+        // Readable summary, for saving alongside the buffer settings it was measured with
+        juce::String toString() const;
+
+        double sampleRate = 0.0;
+        int expectedBlockSize = 0;
+
+        juce::uint64 numCallbacks = 0;
+        juce::uint64 numOverruns = 0;   // Callbacks that took longer than their budget
+        double lastLoad = 0.0;          // Of the latest callback
+        double peakLoad = 0.0;
+        double worstCallbackSeconds = 0.0;
+
+        // Running totals; the difference between two snapshots gives the load in between
+        double busySeconds = 0.0;
+        double budgetSeconds = 0.0;
+
+        std::array<juce::uint64, numHistogramBins> histogram {};
+    };
+
+    Stats getStats() const;
+
+    // Any thread. The audio thread clears the figures at its next callback,
+    // so it stays the only writer.
+    void reset() noexcept  { resetRequested.store(true); }
+
+private:
+    // Audio thread
+    void addCallback(int numSamples, juce::int64 elapsedTicks) noexcept;
+    void clear() noexcept;
+
+    // Relaxed loads and stores are enough: each figure is read on its own, and
+    // a snapshot straddling a callback is off by at most that callback
+    template <typename Type>
+    static void increment(std::atomic<Type>& value) noexcept
+    {
+        value.store(value.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+
+    std::atomic<double> sampleRate { 0.0 };
+    std::atomic<int> expectedBlockSize { 0 };
+    std::atomic<double> secondsPerTick { 0.0 };
+
+    std::atomic<juce::uint64> numCallbacks { 0 };
+    std::atomic<juce::uint64> numOverruns { 0 };
+    std::atomic<double> lastLoad { 0.0 };
+    std::atomic<double> peakLoad { 0.0 };
+    std::atomic<double> worstCallbackSeconds { 0.0 };
+    std::atomic<double> busySeconds { 0.0 };
+    std::atomic<double> budgetSeconds { 0.0 };
+    std::array<std::atomic<juce::uint64>, numHistogramBins> histogram {};
+
+    std::atomic<bool> resetRequested { false };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(CallbackLoadMonitor)
+};
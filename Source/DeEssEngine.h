@@ -0,0 +1,102 @@
+/*
+  ==============================================================================
+
+    DeEssEngine.h
+    Created: 18 Oct 2026 1:48:22am
+    Author:  Leif Rehtanz
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+// One de-essing algorithm with all of its state. Engines are created and
+// prepared on the message thread and then handed to the audio thread whole,
+// so everything but prepare() must be real-time safe.
+class DeEssEngine
+{
+public:
+    // Everything an engine carries from one block into the next, as raw
+    // values. Two engines of the same kind prepared the same way and given
+    // equal states produce bit-identical output for the same input.
+    struct State
+    {
+        std::vector<float> filterState;
+        std::vector<int> hysteresisCounters;
+        std::vector<float> controlState;    // Control-rate detection only
+
+        // Bitwise, so 0.0f and -0.0f are different states
+        bool operator== (const State& other) const
+        {
+            return hysteresisCounters == other.hysteresisCounters
+                && bitwiseEqual(filterState, other.filterState)
+                && bitwiseEqual(controlState, other.controlState);
+        }
+
+        bool operator!= (const State& other) const  { return ! operator== (other); }
+
+    private:
+        static bool bitwiseEqual(const std::vector<float>& a, const std::vector<float>& b)
+        {
+            return a.size() == b.size() && std::memcmp(a.data(), b.data(), a.size() * sizeof(float)) == 0;
+        }
+    };
+
+    // How a gate decides what is sibilant. perSample compares every sample
+    // with the threshold. peak and rms decide once every controlInterval
+    // samples, from that stretch's peak or RMS level, and glide the gain
+    // towards each decision over the next stretch.
+    struct Detection
+    {
+        enum class Mode
+        {
+            perSample,
+            peak,
+            rms
+        };
+
+        static constexpr int minControlInterval = 2;
+        static constexpr int maxControlInterval = 256;
+
+        Mode mode = Mode::perSample;
+        int controlInterval = 16;
+
+        bool operator== (const Detection& other) const noexcept
+        {
+            return mode == other.mode && (mode == Mode::perSample || controlInterval == other.controlInterval);
+        }
+
+        bool operator!= (const Detection& other) const noexcept  { return ! operator== (other); }
+    };
+
+    virtual ~DeEssEngine() = default;
+
+    // Allocates everything, starting from the parameters last passed to
+    // setParameters() without ramping towards them
+    virtual void prepare(double sampleRate, int maximumBlockSize, int numChannels) = 0;
+
+    // Clears all history
+    virtual void reset() = 0;
+
+    // Called at the start of every block with the latest values, in the units
+    // of AudioProcessorManager::setDeEssingParameters(); cheap when nothing moved
+    virtual void setParameters(float thresholdDb, float mixDb, float frequency, int hysteresisSamples) = 0;
+
+    // Called at the start of every block, like setParameters(). Engines
+    // without a sample-domain gate ignore it.
+    virtual void setDetection(const Detection&)  {}
+
+    // In place, at most the prepared block size. Channels beyond the prepared
+    // count pass through.
+    virtual void process(juce::AudioBuffer<float>& buffer, int startSample, int numSamples) = 0;
+
+    // Output delay in samples, valid after prepare()
+    virtual int getLatencySamples() const = 0;
+
+    // State hand-over for splitting renders; engines that can't do it
+    // return false and leave the state alone. These allocate.
+    virtual bool getState(State&) const          { return false; }
+    virtual bool setState(const State&)          { return false; }
+};
@@ -0,0 +1,53 @@
+/*
+  ==============================================================================
+
+    DeEssEngineRegistry.cpp
+    Created: 18 Oct 2026 1:48:22am
+    Author:  Leif Rehtanz
+
+  ==============================================================================
+*/
+
+#include "DeEssEngineRegistry.h"
+#include "AmplitudeThresholdEngine.h"
+#include "SpectralEngine.h"
+
+namespace DeEssEngineRegistry
+{
+    namespace
+    {
+        template <typename EngineType>
+        std::unique_ptr<DeEssEngine> createEngineOfType()
+        {
+            return std::make_unique<EngineType>();
+        }
+    }
+
+    const juce::Array<Entry>& getEntries()
+    {
+        static const juce::Array<Entry> entries
+        {
+            { Algorithm::amplitudeThreshold, "Amplitude Threshold", createEngineOfType<AmplitudeThresholdEngine> },
+            { Algorithm::spectral,           "Spectral Analysis",   createEngineOfType<SpectralEngine> }
+        };
+
+        return entries;
+    }
+
+    const Entry* find(Algorithm algorithm)
+    {
+        for (const auto& entry : getEntries())
+            if (entry.algorithm == algorithm)
+                return &entry;
+
+        return nullptr;
+    }
+
+    std::unique_ptr<DeEssEngine> createEngine(Algorithm algorithm)
+    {
+        const auto* entry = find(algorithm);
+        jassert(entry != nullptr);
+
+        return entry != nullptr ? entry->create() : nullptr;
+    }
+}
@@ -0,0 +1,42 @@
+/*
+  ==============================================================================
+
+    DeEssEngineRegistry.h
+    Created: 18 Oct 2026 1:48:22am
+    Author:  Leif Rehtanz
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "DeEssEngine.h"
+
+// Every de-essing algorithm the app offers, by type. The UI lists the
+// entries' names and hands back an Algorithm; nothing downstream compares
+// strings.
+namespace DeEssEngineRegistry
+{
+    enum class Algorithm
+    {
+        amplitudeThreshold, // Crossover plus hysteresis gate, no latency
+        spectral            // SpectralDeEsser, delayed by its FFT size
+    };
+
+    struct Entry
+    {
+        Algorithm algorithm;
+        const char* name;
+        std::unique_ptr<DeEssEngine> (*create)();
+    };
+
+    // In menu order, default first
+    const juce::Array<Entry>& getEntries();
+
+    // nullptr for an unknown algorithm
+    const Entry* find(Algorithm algorithm);
+
+    // A new, unprepared engine
+    std::unique_ptr<DeEssEngine> createEngine(Algorithm algorithm);
+}
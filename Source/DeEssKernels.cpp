@@ -0,0 +1,447 @@
+/*
+  ==============================================================================
+
+    DeEssKernels.cpp
+    Created: 17 Oct 2026 11:02:15am
+    Author:  Leif Rehtanz
+
+  ==============================================================================
+*/
+
+#include "DeEssKernels.h"
+
+#if JUCE_INTEL
+ #include <immintrin.h>
+
+ // Lets one translation unit hold every variant; MSVC needs no per-function flags
+ #if JUCE_MSVC
+  #define DEESS_TARGET(isa)
+ #else
+  #define DEESS_TARGET(isa) __attribute__((target(isa)))
+ #endif
+#endif
+
+// The AVX-512 target implies FMA; keep every multiply-add as two roundings so
+// the vector variants match the reference bit for bit
+#if JUCE_CLANG
+ #pragma STDC FP_CONTRACT OFF
+#elif JUCE_GCC
+ #pragma GCC optimize ("fp-contract=off")
+#endif
+
+namespace
+{
+    inline int lowestSetBit(juce::uint32 mask)   { return juce::findHighestSetBit(mask & (~mask + 1)); }
+    inline int highestSetBit(juce::uint32 mask)  { return juce::findHighestSetBit(mask); }
+
+    //==============================================================================
+    // Scalar building blocks, also used for the tails of the vector loops
+    template <bool perSampleThreshold>
+    int firstAboveScalar(const float* data, const float* thresholds, float threshold, int start, int numSamples)
+    {
+        for (int i = start; i < numSamples; ++i)
+            if (std::abs(data[i]) > (perSampleThreshold ? thresholds[i] : threshold))
+                return i;
+
+        return numSamples;
+    }
+
+    template <bool perSampleThreshold>
+    int lastAboveScalar(const float* data, const float* thresholds, float threshold, int end)
+    {
+        for (int i = end; --i >= 0;)
+            if (std::abs(data[i]) > (perSampleThreshold ? thresholds[i] : threshold))
+                return i;
+
+        return -1;
+    }
+
+    //==============================================================================
+    // Run-based hysteresis gate shared by the vector variants. Instead of testing
+    // every sample it searches for the next trigger while the gate is closed, and
+    // for the last trigger inside the current hold window while it is open, so the
+    // per-sample work is a vectorised compare. Output is identical to the
+    // reference loop.
+    using FirstAboveFn = int (*)(const float*, const float*, float, int);
+    using LastAboveFn  = int (*)(const float*, const float*, float, int);
+
+    template <FirstAboveFn firstAbove, LastAboveFn lastAbove>
+    void runBasedGate(float* original, float* sibilant, int numSamples,
+                      float threshold, const float* thresholds,
+                      int hysteresisSamples, int& counter)
+    {
+        jassert(hysteresisSamples > 0);
+        auto thresholdsAt = [thresholds] (int offset) { return thresholds != nullptr ? thresholds + offset : nullptr; };
+
+        int pos = 0;
+        int remaining = counter;
+
+        while (pos < numSamples)
+        {
+            if (remaining <= 0)
+            {
+                // Gate closed: everything up to the next trigger is cleared
+                const int trigger = pos + firstAbove(sibilant + pos, thresholdsAt(pos), threshold, numSamples - pos);
+                juce::FloatVectorOperations::clear(sibilant + pos, trigger - pos);
+
+                if (trigger == numSamples)
+                {
+                    remaining = 0;
+                    break;
+                }
+
+                pos = trigger;
+                remaining = hysteresisSamples;
+            }
+            else if (remaining > hysteresisSamples)
+            {
+                // Hold carried over from a longer hysteresis: the next trigger shortens it
+                const int limit = juce::jmin(pos + remaining, numSamples);
+                const int trigger = pos + firstAbove(sibilant + pos, thresholdsAt(pos), threshold, limit - pos);
+                juce::FloatVectorOperations::subtract(original + pos, sibilant + pos, trigger - pos);
+
+                remaining -= trigger - pos;
+                pos = trigger;
+
+                if (trigger == limit)
+                    continue;
+
+                remaining = hysteresisSamples;
+            }
+
+            // Gate open: the hold window ends hysteresisSamples after the last trigger
+            int end = pos + remaining;
+            int scanFrom = pos;
+
+            for (;;)
+            {
+                const int limit = juce::jmin(end, numSamples);
+
+                if (scanFrom >= limit)
+                    break;
+
+                const int last = lastAbove(sibilant + scanFrom, thresholdsAt(scanFrom), threshold, limit - scanFrom);
+
+                if (last < 0)
+                    break;
+
+                end = scanFrom + last + hysteresisSamples;
+                scanFrom = limit;
+            }
+
+            const int activeEnd = juce::jmin(end, numSamples);
+            juce::FloatVectorOperations::subtract(original + pos, sibilant + pos, activeEnd - pos);
+
+            remaining = end - activeEnd;
+            pos = activeEnd;
+        }
+
+        counter = juce::jmax(0, remaining);
+    }
+
+    //==============================================================================
+    // Reference: the original per-sample loops
+    void hysteresisGateReference(float* original, float* sibilant, int numSamples,
+                                 float threshold, const float* thresholds,
+                                 int hysteresisSamples, int& counter)
+    {
+        for (int sample = 0; sample < numSamples; ++sample)
+        {
+            // Check if the sample crosses the upper threshold
+            if (std::abs(sibilant[sample]) > (thresholds != nullptr ? thresholds[sample] : threshold))
+                counter = hysteresisSamples; // Reset the counter
+
+            // If the counter is active, classify as sibilant
+            if (counter > 0)
+            {
+                --counter;
+                original[sample] -= sibilant[sample]; // Subtract sibilant from original
+            }
+            else
+            {
+                sibilant[sample] = 0.0f; // Zero out non-sibilant regions
+            }
+        }
+
+        counter = juce::jmax(0, counter);
+    }
+
+    void mixSibilantsReference(float* dest, const float* original, const float* sibilant,
+                               float gain, const float* gains, int numSamples)
+    {
+        for (int sample = 0; sample < numSamples; ++sample)
+        {
+            dest[sample] = original[sample]; // Copy original data
+            dest[sample] += (gains != nullptr ? gains[sample] : gain) * sibilant[sample]; // Mix sibilants back
+        }
+    }
+
+    const DeEssKernels::KernelSet referenceKernels { "Scalar", hysteresisGateReference, mixSibilantsReference };
+
+   #if JUCE_INTEL
+    //==============================================================================
+    namespace sse2
+    {
+        template <bool perSampleThreshold>
+        DEESS_TARGET("sse2") int firstAbove(const float* data, const float* thresholds, float threshold, int numSamples)
+        {
+            const auto absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff));
+            const auto fixedThreshold = _mm_set1_ps(threshold);
+            int i = 0;
+
+            for (; i + 4 <= numSamples; i += 4)
+            {
+                const auto t = perSampleThreshold ? _mm_loadu_ps(thresholds + i) : fixedThreshold;
+                const auto mask = (juce::uint32) _mm_movemask_ps(_mm_cmpgt_ps(_mm_and_ps(_mm_loadu_ps(data + i), absMask), t));
+
+                if (mask != 0)
+                    return i + lowestSetBit(mask);
+            }
+
+            return firstAboveScalar<perSampleThreshold>(data, thresholds, threshold, i, numSamples);
+        }
+
+        template <bool perSampleThreshold>
+        DEESS_TARGET("sse2") int lastAbove(const float* data, const float* thresholds, float threshold, int numSamples)
+        {
+            const auto absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff));
+            const auto fixedThreshold = _mm_set1_ps(threshold);
+            const int tail = numSamples & 3;
+
+            if (const int last = lastAboveScalar<perSampleThreshold>(data + numSamples - tail,
+                                                                     perSampleThreshold ? thresholds + numSamples - tail : nullptr,
+                                                                     threshold, tail); last >= 0)
+                return numSamples - tail + last;
+
+            for (int i = numSamples - tail; (i -= 4) >= 0;)
+            {
+                const auto t = perSampleThreshold ? _mm_loadu_ps(thresholds + i) : fixedThreshold;
+                const auto mask = (juce::uint32) _mm_movemask_ps(_mm_cmpgt_ps(_mm_and_ps(_mm_loadu_ps(data + i), absMask), t));
+
+                if (mask != 0)
+                    return i + highestSetBit(mask);
+            }
+
+            return -1;
+        }
+
+        int firstAboveDispatch(const float* data, const float* thresholds, float threshold, int numSamples)
+        {
+            return thresholds != nullptr ? firstAbove<true>(data, thresholds, threshold, numSamples)
+                                         : firstAbove<false>(data, thresholds, threshold, numSamples);
+        }
+
+        int lastAboveDispatch(const float* data, const float* thresholds, float threshold, int numSamples)
+        {
+            return thresholds != nullptr ? lastAbove<true>(data, thresholds, threshold, numSamples)
+                                         : lastAbove<false>(data, thresholds, threshold, numSamples);
+        }
+
+        DEESS_TARGET("sse2") void mixSibilants(float* dest, const float* original, const float* sibilant,
+                                               float gain, const float* gains, int numSamples)
+        {
+            const auto fixedGain = _mm_set1_ps(gain);
+            int i = 0;
+
+            for (; i + 4 <= numSamples; i += 4)
+            {
+                const auto g = gains != nullptr ? _mm_loadu_ps(gains + i) : fixedGain;
+                _mm_storeu_ps(dest + i, _mm_add_ps(_mm_loadu_ps(original + i), _mm_mul_ps(g, _mm_loadu_ps(sibilant + i))));
+            }
+
+            mixSibilantsReference(dest + i, original + i, sibilant + i, gain, gains != nullptr ? gains + i : nullptr, numSamples - i);
+        }
+
+        const DeEssKernels::KernelSet kernels { "SSE2", runBasedGate<firstAboveDispatch, lastAboveDispatch>, mixSibilants };
+    }
+
+    //==============================================================================
+    namespace avx2
+    {
+        template <bool perSampleThreshold>
+        DEESS_TARGET("avx2") int firstAbove(const float* data, const float* thresholds, float threshold, int numSamples)
+        {
+            const auto absMask = _mm256_castsi256_ps(_mm256_set1_epi32(0x7fffffff));
+            const auto fixedThreshold = _mm256_set1_ps(threshold);
+            int i = 0;
+
+            for (; i + 8 <= numSamples; i += 8)
+            {
+                const auto t = perSampleThreshold ? _mm256_loadu_ps(thresholds + i) : fixedThreshold;
+                const auto mask = (juce::uint32) _mm256_movemask_ps(_mm256_cmp_ps(_mm256_and_ps(_mm256_loadu_ps(data + i), absMask), t, _CMP_GT_OQ));
+
+                if (mask != 0)
+                    return i + lowestSetBit(mask);
+            }
+
+            return firstAboveScalar<perSampleThreshold>(data, thresholds, threshold, i, numSamples);
+        }
+
+        template <bool perSampleThreshold>
+        DEESS_TARGET("avx2") int lastAbove(const float* data, const float* thresholds, float threshold, int numSamples)
+        {
+            const auto absMask = _mm256_castsi256_ps(_mm256_set1_epi32(0x7fffffff));
+            const auto fixedThreshold = _mm256_set1_ps(threshold);
+            const int tail = numSamples & 7;
+
+            if (const int last = lastAboveScalar<perSampleThreshold>(data + numSamples - tail,
+                                                                     perSampleThreshold ? thresholds + numSamples - tail : nullptr,
+                                                                     threshold, tail); last >= 0)
+                return numSamples - tail + last;
+
+            for (int i = numSamples - tail; (i -= 8) >= 0;)
+            {
+                const auto t = perSampleThreshold ? _mm256_loadu_ps(thresholds + i) : fixedThreshold;
+                const auto mask = (juce::uint32) _mm256_movemask_ps(_mm256_cmp_ps(_mm256_and_ps(_mm256_loadu_ps(data + i), absMask), t, _CMP_GT_OQ));
+
+                if (mask != 0)
+                    return i + highestSetBit(mask);
+            }
+
+            return -1;
+        }
+
+        int firstAboveDispatch(const float* data, const float* thresholds, float threshold, int numSamples)
+        {
+            return thresholds != nullptr ? firstAbove<true>(data, thresholds, threshold, numSamples)
+                                         : firstAbove<false>(data, thresholds, threshold, numSamples);
+        }
+
+        int lastAboveDispatch(const float* data, const float* thresholds, float threshold, int numSamples)
+        {
+            return thresholds != nullptr ? lastAbove<true>(data, thresholds, threshold, numSamples)
+                                         : lastAbove<false>(data, thresholds, threshold, numSamples);
+        }
+
+        // Deliberately no FMA, so the result rounds exactly like the reference
+        DEESS_TARGET("avx2") void mixSibilants(float* dest, const float* original, const float* sibilant,
+                                               float gain, const float* gains, int numSamples)
+        {
+            const auto fixedGain = _mm256_set1_ps(gain);
+            int i = 0;
+
+            for (; i + 8 <= numSamples; i += 8)
+            {
+                const auto g = gains != nullptr ? _mm256_loadu_ps(gains + i) : fixedGain;
+                _mm256_storeu_ps(dest + i, _mm256_add_ps(_mm256_loadu_ps(original + i), _mm256_mul_ps(g, _mm256_loadu_ps(sibilant + i))));
+            }
+
+            mixSibilantsReference(dest + i, original + i, sibilant + i, gain, gains != nullptr ? gains + i : nullptr, numSamples - i);
+        }
+
+        const DeEssKernels::KernelSet kernels { "AVX2", runBasedGate<firstAboveDispatch, lastAboveDispatch>, mixSibilants };
+    }
+
+    //==============================================================================
+    namespace avx512
+    {
+        DEESS_TARGET("avx512f") inline __m512 abs(__m512 x)
+        {
+            return _mm512_castsi512_ps(_mm512_and_si512(_mm512_castps_si512(x), _mm512_set1_epi32(0x7fffffff)));
+        }
+
+        template <bool perSampleThreshold>
+        DEESS_TARGET("avx512f") int firstAbove(const float* data, const float* thresholds, float threshold, int numSamples)
+        {
+            const auto fixedThreshold = _mm512_set1_ps(threshold);
+            int i = 0;
+
+            for (; i + 16 <= numSamples; i += 16)
+            {
+                const auto t = perSampleThreshold ? _mm512_loadu_ps(thresholds + i) : fixedThreshold;
+                const auto mask = (juce::uint32) _mm512_cmp_ps_mask(abs(_mm512_loadu_ps(data + i)), t, _CMP_GT_OQ);
+
+                if (mask != 0)
+                    return i + lowestSetBit(mask);
+            }
+
+            return firstAboveScalar<perSampleThreshold>(data, thresholds, threshold, i, numSamples);
+        }
+
+        template <bool perSampleThreshold>
+        DEESS_TARGET("avx512f") int lastAbove(const float* data, const float* thresholds, float threshold, int numSamples)
+        {
+            const auto fixedThreshold = _mm512_set1_ps(threshold);
+            const int tail = numSamples & 15;
+
+            if (const int last = lastAboveScalar<perSampleThreshold>(data + numSamples - tail,
+                                                                     perSampleThreshold ? thresholds + numSamples - tail : nullptr,
+                                                                     threshold, tail); last >= 0)
+                return numSamples - tail + last;
+
+            for (int i = numSamples - tail; (i -= 16) >= 0;)
+            {
+                const auto t = perSampleThreshold ? _mm512_loadu_ps(thresholds + i) : fixedThreshold;
+                const auto mask = (juce::uint32) _mm512_cmp_ps_mask(abs(_mm512_loadu_ps(data + i)), t, _CMP_GT_OQ);
+
+                if (mask != 0)
+                    return i + highestSetBit(mask);
+            }
+
+            return -1;
+        }
+
+        int firstAboveDispatch(const float* data, const float* thresholds, float threshold, int numSamples)
+        {
+            return thresholds != nullptr ? firstAbove<true>(data, thresholds, threshold, numSamples)
+                                         : firstAbove<false>(data, thresholds, threshold, numSamples);
+        }
+
+        int lastAboveDispatch(const float* data, const float* thresholds, float threshold, int numSamples)
+        {
+            return thresholds != nullptr ? lastAbove<true>(data, thresholds, threshold, numSamples)
+                                         : lastAbove<false>(data, thresholds, threshold, numSamples);
+        }
+
+        DEESS_TARGET("avx512f") void mixSibilants(float* dest, const float* original, const float* sibilant,
+                                                  float gain, const float* gains, int numSamples)
+        {
+            const auto fixedGain = _mm512_set1_ps(gain);
+            int i = 0;
+
+            for (; i + 16 <= numSamples; i += 16)
+            {
+                const auto g = gains != nullptr ? _mm512_loadu_ps(gains + i) : fixedGain;
+                _mm512_storeu_ps(dest + i, _mm512_add_ps(_mm512_loadu_ps(original + i), _mm512_mul_ps(g, _mm512_loadu_ps(sibilant + i))));
+            }
+
+            mixSibilantsReference(dest + i, original + i, sibilant + i, gain, gains != nullptr ? gains + i : nullptr, numSamples - i);
+        }
+
+        const DeEssKernels::KernelSet kernels { "AVX-512", runBasedGate<firstAboveDispatch, lastAboveDispatch>, mixSibilants };
+    }
+   #endif
+}
+
+namespace DeEssKernels
+{
+    const KernelSet& getReferenceKernels()
+    {
+        return referenceKernels;
+    }
+
+    juce::Array<const KernelSet*> getAvailableKernels()
+    {
+        juce::Array<const KernelSet*> available;
+        available.add(&referenceKernels);
+
+       #if JUCE_INTEL
+        if (juce::SystemStats::hasSSE2())    available.add(&sse2::kernels);
+        if (juce::SystemStats::hasAVX2())    available.add(&avx2::kernels);
+        if (juce::SystemStats::hasAVX512F()) available.add(&avx512::kernels);
+       #endif
+
+        return available;
+    }
+
+    const KernelSet& getBestKernels()
+    {
+        static const KernelSet* best = []
+        {
+            auto available = getAvailableKernels();
+            return available[available.size() - 1];
+        }();
+
+        return *best;
+    }
+}
@@ -0,0 +1,49 @@
+/*
+  ==============================================================================
+
+    DeEssKernels.h
+    Created: 17 Oct 2026 11:02:15am
+    Author:  Leif Rehtanz
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+// Inner loops of the de-esser, with scalar, SSE2, AVX2 and AVX-512 variants.
+// The best variant for the running CPU is picked once, the first time
+// getBestKernels() is called; call it from the message thread before audio
+// starts so that detection never happens on the audio thread.
+namespace DeEssKernels
+{
+    struct KernelSet
+    {
+        const char* name;
+
+        // Hysteresis gate over one channel, in place. Samples classified as
+        // sibilant are subtracted from original; all other samples are
+        // cleared from sibilant. A sample above the threshold (linear gain)
+        // re-arms counter with hysteresisSamples, which must be at least 1.
+        // If thresholds is non-null it holds one threshold per sample and
+        // threshold is ignored.
+        void (*hysteresisGate)(float* original, float* sibilant, int numSamples,
+                               float threshold, const float* thresholds,
+                               int hysteresisSamples, int& counter);
+
+        // dest = original + gain * sibilant. If gains is non-null it holds one
+        // gain per sample and gain is ignored.
+        void (*mixSibilants)(float* dest, const float* original, const float* sibilant,
+                             float gain, const float* gains, int numSamples);
+    };
+
+    // Fastest variant supported by this CPU
+    const KernelSet& getBestKernels();
+
+    // Plain per-sample loops; the vector variants must match these exactly
+    const KernelSet& getReferenceKernels();
+
+    // Every variant this CPU can run, reference first
+    juce::Array<const KernelSet*> getAvailableKernels();
+}
@@ -0,0 +1,305 @@
+/*
+  ==============================================================================
+
+    DecodedAudioCache.cpp
+    Created: 18 Oct 2026 12:52:37am
+    Author:  Leif Rehtanz
+
+  ==============================================================================
+*/
+
+#include "DecodedAudioCache.h"
+#include <algorithm>
+#include <limits>
+
+namespace
+{
+    // Decoded a block at a time so the background thread can stop part way
+    constexpr int decodeBlockSize = 1 << 18;
+}
+
+DecodedAudioCache::Key DecodedAudioCache::Key::forFile(const juce::File& file)
+{
+    return { file, file.getSize(), file.getLastModificationTime() };
+}
+
+bool DecodedAudioCache::Key::operator== (const Key& other) const noexcept
+{
+    return file == other.file && size == other.size && modificationTime == other.modificationTime;
+}
+
+DecodedAudioCache::DecodedAudioCache(juce::AudioFormatManager& formatManagerToUse, size_t maxBytesToKeep)
+    : juce::Thread("Audio decode prefetch"),
+      formatManager(formatManagerToUse),
+      maxBytes(maxBytesToKeep)
+{
+    startThread(juce::Thread::Priority::low);
+}
+
+DecodedAudioCache::~DecodedAudioCache()
+{
+    signalThreadShouldExit();
+    notify();
+    stopThread(4000);
+}
+
+bool DecodedAudioCache::canMemoryMap(juce::AudioFormatManager& formatManager, const juce::File& file)
+{
+    for (auto* format : formatManager)
+    {
+        if (! format->canHandleFile(file))
+            continue;
+
+        std::unique_ptr<juce::MemoryMappedAudioFormatReader> mappedReader(format->createMemoryMappedReader(file));
+
+        if (mappedReader != nullptr && mappedReader->mapEntireFile())
+            return true;
+    }
+
+    return false;
+}
+
+std::shared_ptr<const DecodedAudioCache::PendingAudio> DecodedAudioCache::get(const juce::File& file)
+{
+    const auto key = Key::forFile(file);
+    auto pending = std::make_shared<PendingAudio>();
+
+    {
+        const juce::ScopedLock sl(lock);
+
+        if (auto audio = findAndTouch(key))
+        {
+            pending->setAudio(std::move(audio));
+            return pending;
+        }
+
+        // Opened again before it's done: share the one decode
+        for (const auto& request : requests)
+            if (request.key == key)
+                if (auto existing = request.pending.lock())
+                    return existing;
+
+        // The file opened last is the one being looked at
+        requests.insert(requests.begin(), { key, pending });
+    }
+
+    notify();
+    return pending;
+}
+
+void DecodedAudioCache::prefetch(const juce::File& file)
+{
+    const auto key = Key::forFile(file);
+
+    {
+        const juce::ScopedLock sl(lock);
+
+        if (isQueuedOrCached(key))
+            return;
+
+        prefetchQueue.push_back(key);
+    }
+
+    notify();
+}
+
+size_t DecodedAudioCache::getBytesUsed() const
+{
+    const juce::ScopedLock sl(lock);
+    return bytesUsed;
+}
+
+void DecodedAudioCache::run()
+{
+    while (! threadShouldExit())
+    {
+        Key key;
+        bool isRequested = false;
+
+        {
+            const juce::ScopedLock sl(lock);
+
+            // Files closed before their turn came
+            requests.erase(std::remove_if(requests.begin(), requests.end(),
+                                          [] (const Request& request) { return request.pending.expired(); }),
+                           requests.end());
+
+            if (! requests.empty())
+            {
+                key = requests.front().key;
+                isRequested = true;
+            }
+            else if (! prefetchQueue.empty())
+            {
+                key = prefetchQueue.front();
+            }
+            else
+            {
+                const juce::ScopedUnlock su(lock);
+                wait(-1);
+                continue;
+            }
+
+            prefetchQueue.erase(std::remove(prefetchQueue.begin(), prefetchQueue.end(), key), prefetchQueue.end());
+            decodingKey = key;
+            isDecoding = true;
+        }
+
+        // Nothing bigger than the budget is decoded, so memory use doesn't
+        // grow with the length of a take; readers keep streaming those.
+        // Mapped files read straight from the page cache.
+        bool madeWay = false;
+
+        const auto shouldStop = [this, &key, isRequested, &madeWay]
+        {
+            if (threadShouldExit())
+                return true;
+
+            const juce::ScopedLock sl(lock);
+
+            // Everyone who opened the file has closed it again
+            if (isRequested)
+                return ! hasLiveRequest(key);
+
+            // A prefetch makes way for a file that has just been opened
+            madeWay = hasLiveRequestOtherThan(key);
+            return madeWay;
+        };
+
+        std::shared_ptr<const DecodedAudio> audio;
+
+        if (isRequested || ! canMemoryMap(formatManager, key.file))
+            audio = decode(key.file, maxBytes, shouldStop);
+
+        {
+            const juce::ScopedLock sl(lock);
+
+            if (madeWay)
+            {
+                // Picked up again once the open files are done
+                prefetchQueue.insert(prefetchQueue.begin(), key);
+            }
+            else
+            {
+                if (audio != nullptr)
+                    add(key, audio);
+
+                for (const auto& request : requests)
+                    if (request.key == key)
+                        if (auto pending = request.pending.lock())
+                            pending->setAudio(audio);
+
+                requests.erase(std::remove_if(requests.begin(), requests.end(),
+                                              [&key] (const Request& request) { return request.key == key; }),
+                               requests.end());
+            }
+
+            isDecoding = false;
+        }
+    }
+}
+
+std::shared_ptr<const DecodedAudioCache::DecodedAudio> DecodedAudioCache::decode(const juce::File& file,
+                                                                                 size_t sizeLimit,
+                                                                                 const std::function<bool()>& shouldStop) const
+{
+    std::unique_ptr<juce::AudioFormatReader> reader(formatManager.createReaderFor(file));
+
+    // AudioBuffer lengths are ints
+    if (reader == nullptr || reader->numChannels == 0 || reader->lengthInSamples <= 0
+         || reader->lengthInSamples > std::numeric_limits<int>::max())
+        return nullptr;
+
+    const int numChannels = (int) reader->numChannels;
+    const int numSamples = (int) reader->lengthInSamples;
+
+    if ((size_t) numChannels * (size_t) numSamples * sizeof(float) > sizeLimit)
+        return nullptr;
+
+    auto audio = std::make_shared<DecodedAudio>();
+    audio->samples.setSize(numChannels, numSamples);
+    audio->sampleRate = reader->sampleRate;
+    audio->sourceBitsPerSample = reader->bitsPerSample;
+    audio->formatName = reader->getFormatName();
+    audio->metadataValues = reader->metadataValues;
+
+    for (int position = 0; position < numSamples; position += decodeBlockSize)
+    {
+        if (shouldStop())
+            return nullptr;
+
+        const int numToRead = juce::jmin(decodeBlockSize, numSamples - position);
+
+        if (! reader->read(&audio->samples, position, numToRead, position, true, true))
+            return nullptr;
+    }
+
+    return audio;
+}
+
+std::shared_ptr<const DecodedAudioCache::DecodedAudio> DecodedAudioCache::findAndTouch(const Key& key)
+{
+    for (auto& entry : entries)
+    {
+        if (entry.key == key)
+        {
+            entry.lastUsed = ++useCounter;
+            return entry.audio;
+        }
+    }
+
+    return nullptr;
+}
+
+void DecodedAudioCache::add(const Key& key, std::shared_ptr<const DecodedAudio> audio)
+{
+    const auto size = audio->getSizeInBytes();
+
+    if (size > maxBytes || findAndTouch(key) != nullptr)
+        return;
+
+    entries.push_back({ key, std::move(audio), ++useCounter });
+    bytesUsed += size;
+
+    // The new entry is the most recent, so it's the last to go, and it fits on its own
+    while (bytesUsed > maxBytes)
+    {
+        auto oldest = std::min_element(entries.begin(), entries.end(), [] (const Entry& a, const Entry& b)
+        {
+            return a.lastUsed < b.lastUsed;
+        });
+
+        bytesUsed -= oldest->audio->getSizeInBytes();
+        entries.erase(oldest);
+    }
+}
+
+bool DecodedAudioCache::isQueuedOrCached(const Key& key) const
+{
+    if (isDecoding && decodingKey == key)
+        return true;
+
+    if (std::any_of(requests.begin(), requests.end(), [&key] (const Request& request) { return request.key == key; }))
+        return true;
+
+    if (std::find(prefetchQueue.begin(), prefetchQueue.end(), key) != prefetchQueue.end())
+        return true;
+
+    return std::any_of(entries.begin(), entries.end(), [&key] (const Entry& entry) { return entry.key == key; });
+}
+
+bool DecodedAudioCache::hasLiveRequest(const Key& key) const
+{
+    return std::any_of(requests.begin(), requests.end(), [&key] (const Request& request)
+    {
+        return request.key == key && ! request.pending.expired();
+    });
+}
+
+bool DecodedAudioCache::hasLiveRequestOtherThan(const Key& key) const
+{
+    return std::any_of(requests.begin(), requests.end(), [&key] (const Request& request)
+    {
+        return ! (request.key == key) && ! request.pending.expired();
+    });
+}
@@ -0,0 +1,141 @@
+/*
+  ==============================================================================
+
+    DecodedAudioCache.h
+    Created: 18 Oct 2026 12:52:37am
+    Author:  Leif Rehtanz
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <atomic>
+#include <functional>
+#include <vector>
+
+// Whole files decoded to float PCM, for formats that can't be memory-mapped
+// (FLAC, Ogg, MP3, ...), so switching back to a take doesn't decode it again.
+// The least recently used files are dropped once the cache holds more than
+// its byte budget; a file bigger than the whole budget is never decoded,
+// and is streamed from disk instead. All decoding happens on a background
+// thread: files that are open first, newest first, then prefetched ones, so
+// the next take in a session is ready before it's opened.
+//
+// Files are matched by path, size and modification time, so a take that
+// has been re-exported is decoded afresh.
+class DecodedAudioCache : private juce::Thread
+{
+public:
+    struct DecodedAudio
+    {
+        juce::AudioBuffer<float> samples;
+        double sampleRate = 0.0;
+        unsigned int sourceBitsPerSample = 0;
+        juce::String formatName;
+        juce::StringPairArray metadataValues;
+
+        size_t getSizeInBytes() const noexcept
+        {
+            return (size_t) samples.getNumChannels() * (size_t) samples.getNumSamples() * sizeof(float);
+        }
+    };
+
+    // Decoded audio that may still be on its way. The background thread sets
+    // it once; any thread can check for it without locking.
+    class PendingAudio
+    {
+    public:
+        // nullptr until the decode has finished, and for good if it failed
+        std::shared_ptr<const DecodedAudio> getIfReady() const
+        {
+            return isReady.load(std::memory_order_acquire) ? audio : nullptr;
+        }
+
+    private:
+        friend class DecodedAudioCache;
+
+        void setAudio(std::shared_ptr<const DecodedAudio> decodedAudio)
+        {
+            audio = std::move(decodedAudio);
+            isReady.store(true, std::memory_order_release);
+        }
+
+        std::shared_ptr<const DecodedAudio> audio;
+        std::atomic<bool> isReady { false };
+    };
+
+    DecodedAudioCache(juce::AudioFormatManager& formatManagerToUse, size_t maxBytesToKeep);
+    ~DecodedAudioCache() override;
+
+    // Returns at once and never decodes on the calling thread. A cached file
+    // is ready straight away; anything else is decoded in the background
+    // ahead of any prefetches and shows up in the result when it's done.
+    // Files bigger than the budget, or that fail to decode, stay null.
+    // Dropping every result for the file before then cancels its decode.
+    std::shared_ptr<const PendingAudio> get(const juce::File& file);
+
+    // Queues the file for the background thread and returns at once; files
+    // that are cached, too big to keep or memory-mappable are skipped
+    void prefetch(const juce::File& file);
+
+    // Bytes held by the cache itself; files still open elsewhere can hold more
+    size_t getBytesUsed() const;
+
+    // True for files that MappedAudioFile maps instead of decoding
+    static bool canMemoryMap(juce::AudioFormatManager& formatManager, const juce::File& file);
+
+private:
+    struct Key
+    {
+        juce::File file;
+        juce::int64 size = 0;
+        juce::Time modificationTime;
+
+        static Key forFile(const juce::File& file);
+        bool operator== (const Key& other) const noexcept;
+    };
+
+    struct Entry
+    {
+        Key key;
+        std::shared_ptr<const DecodedAudio> audio;
+        juce::uint64 lastUsed = 0;
+    };
+
+    // A get() still waiting for its file
+    struct Request
+    {
+        Key key;
+        std::weak_ptr<PendingAudio> pending;
+    };
+
+    void run() override;
+
+    // Unlocked. nullptr for files bigger than sizeLimit once decoded; shouldStop
+    // lets the background thread give up part way.
+    std::shared_ptr<const DecodedAudio> decode(const juce::File& file, size_t sizeLimit,
+                                               const std::function<bool()>& shouldStop) const;
+
+    // Called with the lock held
+    std::shared_ptr<const DecodedAudio> findAndTouch(const Key& key);
+    void add(const Key& key, std::shared_ptr<const DecodedAudio> audio);
+    bool isQueuedOrCached(const Key& key) const;
+    bool hasLiveRequest(const Key& key) const;
+    bool hasLiveRequestOtherThan(const Key& key) const;
+
+    juce::AudioFormatManager& formatManager;
+    const size_t maxBytes;
+
+    juce::CriticalSection lock;
+    std::vector<Entry> entries;
+    std::vector<Request> requests;
+    std::vector<Key> prefetchQueue;
+    Key decodingKey;            // Being decoded by the background thread
+    bool isDecoding = false;
+    juce::uint64 useCounter = 0;
+    size_t bytesUsed = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(DecodedAudioCache)
+};
@@ -0,0 +1,109 @@
+/*
+  ==============================================================================
+
+    DoubleBufferedWriter.cpp
+    Created: 17 Oct 2026 11:12:03pm
+    Author:  Leif Rehtanz
+
+  ==============================================================================
+*/
+
+#include "DoubleBufferedWriter.h"
+
+DoubleBufferedWriter::DoubleBufferedWriter(std::unique_ptr<juce::AudioFormatWriter> writerToUse,
+                                           int numChannels, int bufferSamples)
+    : juce::Thread("Audio file writer"),
+      writer(std::move(writerToUse))
+{
+    jassert(writer != nullptr);
+
+    for (auto& buffer : buffers)
+        buffer.setSize(numChannels, juce::jmax(1, bufferSamples));
+
+    startThread();
+}
+
+DoubleBufferedWriter::~DoubleBufferedWriter()
+{
+    flush();
+
+    signalThreadShouldExit();
+    bufferHandedOver.signal();
+    stopThread(-1);
+
+    // Deleting the writer finalises the file's header
+    writer.reset();
+}
+
+bool DoubleBufferedWriter::write(const juce::AudioBuffer<float>& source, int startSample, int numSamples)
+{
+    const int numChannels = juce::jmin(source.getNumChannels(), buffers[0].getNumChannels());
+    const int capacity = buffers[0].getNumSamples();
+
+    while (numSamples > 0 && ! writeFailed.load())
+    {
+        const int numToCopy = juce::jmin(numSamples, capacity - numFilled);
+
+        for (int channel = 0; channel < numChannels; ++channel)
+            buffers[(size_t) fillingIndex].copyFrom(channel, numFilled, source, channel, startSample, numToCopy);
+
+        numFilled += numToCopy;
+        startSample += numToCopy;
+        numSamples -= numToCopy;
+
+        if (numFilled == capacity)
+            handOverFilledBuffer();
+    }
+
+    return ! writeFailed.load();
+}
+
+bool DoubleBufferedWriter::flush()
+{
+    if (numFilled > 0)
+        handOverFilledBuffer();
+
+    waitUntilWriterIdle();
+
+    if (! writer->flush())
+        writeFailed.store(true);
+
+    return ! writeFailed.load();
+}
+
+void DoubleBufferedWriter::waitUntilWriterIdle()
+{
+    while (writerBusy.load())
+        bufferWritten.wait(50);
+}
+
+void DoubleBufferedWriter::handOverFilledBuffer()
+{
+    // The other buffer becomes free once the thread has written it
+    waitUntilWriterIdle();
+
+    writingIndex = fillingIndex;
+    numToWrite = numFilled;
+    writerBusy.store(true);
+    bufferHandedOver.signal();
+
+    fillingIndex = 1 - fillingIndex;
+    numFilled = 0;
+}
+
+void DoubleBufferedWriter::run()
+{
+    while (! threadShouldExit())
+    {
+        bufferHandedOver.wait(100);
+
+        if (! writerBusy.load())
+            continue;
+
+        if (! writer->writeFromAudioSampleBuffer(buffers[(size_t) writingIndex], 0, numToWrite))
+            writeFailed.store(true);
+
+        writerBusy.store(false);
+        bufferWritten.signal();
+    }
+}
@@ -0,0 +1,54 @@
+/*
+  ==============================================================================
+
+    DoubleBufferedWriter.h
+    Created: 17 Oct 2026 11:12:03pm
+    Author:  Leif Rehtanz
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <array>
+
+// Moves encoding and disk writes off the rendering thread. There are two
+// buffers: the caller fills one while a background thread writes the other,
+// so rendering only waits when it gets a whole buffer ahead of the disk.
+// One thread calls write() and flush(); the writer is finalised when this is
+// deleted.
+class DoubleBufferedWriter : private juce::Thread
+{
+public:
+    DoubleBufferedWriter(std::unique_ptr<juce::AudioFormatWriter> writerToUse, int numChannels, int bufferSamples);
+    ~DoubleBufferedWriter() override;
+
+    // Copies the samples in. False once any earlier write has failed.
+    bool write(const juce::AudioBuffer<float>& source, int startSample, int numSamples);
+
+    // Writes out everything buffered so far and waits for it
+    bool flush();
+
+private:
+    void run() override;
+    void handOverFilledBuffer();
+    void waitUntilWriterIdle();
+
+    std::unique_ptr<juce::AudioFormatWriter> writer;
+
+    std::array<juce::AudioBuffer<float>, 2> buffers;
+    int fillingIndex = 0;
+    int numFilled = 0;
+
+    // Set by the caller before writerBusy, cleared by the thread after it
+    int writingIndex = 0;
+    int numToWrite = 0;
+    std::atomic<bool> writerBusy { false };
+    std::atomic<bool> writeFailed { false };
+
+    juce::WaitableEvent bufferHandedOver;
+    juce::WaitableEvent bufferWritten;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(DoubleBufferedWriter)
+};
@@ -0,0 +1,79 @@
+/*
+  ==============================================================================
+
+    FileExporter.cpp
+    Created: 17 Oct 2026 11:40:26pm
+    Author:  Leif Rehtanz
+
+  ==============================================================================
+*/
+
+#include "FileExporter.h"
+
+FileExporter::FileExporter()
+    : juce::Thread("File export")
+{
+    formatManager.registerBasicFormats();
+}
+
+FileExporter::~FileExporter()
+{
+    stopThread(4000);
+}
+
+bool FileExporter::start(const juce::File& inputFile, const juce::File& outputFile, const OfflineRenderer::Settings& settings)
+{
+    if (isExporting() || outputFile == inputFile)
+        return false;
+
+    // The last export's thread has finished its work but may not have returned yet
+    stopThread(4000);
+
+    input = inputFile;
+    output = outputFile;
+    exportSettings = settings;
+
+    progress = 0.0;
+    exporting = true;
+
+    // Below playback's read-ahead and the audio thread, level with the analysis
+    startThread(juce::Thread::Priority::low);
+    return true;
+}
+
+void FileExporter::cancel()
+{
+    signalThreadShouldExit();
+}
+
+OfflineRenderer::Result FileExporter::getResult() const
+{
+    const juce::ScopedLock sl(resultLock);
+    return result;
+}
+
+juce::File FileExporter::getOutputFile() const
+{
+    return output;
+}
+
+void FileExporter::run()
+{
+    auto newResult = renderer.renderFile(formatManager, input, output, exportSettings, [this] (double fraction)
+    {
+        progress = fraction;
+        return ! threadShouldExit();
+    });
+
+    // Leave nothing half-written behind
+    if (! newResult.wasSuccessful())
+        output.deleteFile();
+
+    {
+        const juce::ScopedLock sl(resultLock);
+        result = newResult;
+    }
+
+    exporting = false;
+    sendChangeMessage();
+}
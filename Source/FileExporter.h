@@ -0,0 +1,60 @@
+/*
+  ==============================================================================
+
+    FileExporter.h
+    Created: 17 Oct 2026 11:40:26pm
+    Author:  Leif Rehtanz
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "OfflineRenderer.h"
+
+// Renders a de-essed copy of a file on a background thread, so the UI and
+// playback carry on while it runs. Encoding and disk writes go to a second
+// thread (OfflineRenderer::Settings::writeOnBackgroundThread), so neither
+// the disk nor the processing waits on the other. Progress can be polled
+// from any thread; a change message goes out when an export has finished,
+// failed or been cancelled.
+class FileExporter : public juce::ChangeBroadcaster,
+                     private juce::Thread
+{
+public:
+    FileExporter();
+    ~FileExporter() override;
+
+    // Message thread. False if an export is already running or the output
+    // would overwrite the input.
+    bool start(const juce::File& inputFile, const juce::File& outputFile, const OfflineRenderer::Settings& settings);
+
+    // Stops at the next block and deletes the partial output
+    void cancel();
+
+    bool isExporting() const noexcept     { return exporting.load(); }
+    double getProgress() const noexcept   { return progress.load(); }
+
+    // Of the last export to finish
+    OfflineRenderer::Result getResult() const;
+    juce::File getOutputFile() const;
+
+private:
+    void run() override;
+
+    juce::AudioFormatManager formatManager;
+    OfflineRenderer renderer;
+
+    // Written by start() while no export runs
+    juce::File input, output;
+    OfflineRenderer::Settings exportSettings;
+
+    std::atomic<bool> exporting { false };
+    std::atomic<double> progress { 0.0 };
+
+    juce::CriticalSection resultLock;
+    OfflineRenderer::Result result;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(FileExporter)
+};
@@ -1,252 +1,545 @@
-#include "MainComponent.h"
-
-MainComponent::MainComponent()
-: state(Stopped),
-  waveformCache(5),
-waveformDisplay(512, formatManager, waveformCache),
-  positionOverlay(transportSource)
-{
-    addAndMakeVisible(&openButton);
-    openButton.setButtonText("Open...");
-    openButton.onClick = [this] { openButtonClicked(); };
-
-    addAndMakeVisible(&playButton);
-    playButton.setButtonText("Play");
-    playButton.onClick = [this] { playButtonClicked(); };
-    playButton.setColour(juce::TextButton::buttonColourId, juce::Colours::green);
-    playButton.setEnabled(false);
-
-    addAndMakeVisible(&stopButton);
-    stopButton.setButtonText("Stop");
-    stopButton.onClick = [this] { stopButtonClicked(); };
-    stopButton.setColour(juce::TextButton::buttonColourId, juce::Colours::red);
-    stopButton.setEnabled(false);
-    
-    addAndMakeVisible(&waveformDisplay);
-    addAndMakeVisible(&positionOverlay);
-    
-    addAndMakeVisible(algorithmSelector);
-    addAndMakeVisible(filterControl);
-    
-    fileLabel.setText("No File Loaded", juce::dontSendNotification);
-    fileLabel.setJustificationType(juce::Justification::centredLeft);
-    addAndMakeVisible(fileLabel);
-        
-
-    filterControl.frequencySlider.onValueChange = [this]()
-    {
-        processorManager.setDeEssingParameters(
-            filterControl.thresholdSlider.getValue(),
-            filterControl.reductionSlider.getValue(),
-            filterControl.frequencySlider.getValue(),
-            filterControl.hysteresisSlider.getValue()
-        );
-
-        DBG("Frequency Slider Changed: " << filterControl.frequencySlider.getValue() << " Hz");
-    };
-
-    filterControl.thresholdSlider.onValueChange = [this]()
-    {
-        processorManager.setDeEssingParameters(
-            filterControl.thresholdSlider.getValue(),
-            filterControl.reductionSlider.getValue(),
-            filterControl.frequencySlider.getValue(),
-            filterControl.hysteresisSlider.getValue()
-        );
-
-        DBG("Threshold Slider Changed: " << filterControl.thresholdSlider.getValue() << " dB");
-    };
-
-    filterControl.reductionSlider.onValueChange = [this]()
-    {
-        processorManager.setDeEssingParameters(
-            filterControl.thresholdSlider.getValue(),
-            filterControl.reductionSlider.getValue(),
-            filterControl.frequencySlider.getValue(),
-            filterControl.hysteresisSlider.getValue()
-        );
-
-        DBG("Reduction Slider Changed: " << filterControl.reductionSlider.getValue() << " dB");
-    };
-    
-    filterControl.hysteresisSlider.onValueChange = [this]()
-    {
-        processorManager.setDeEssingParameters(
-            filterControl.thresholdSlider.getValue(),
-            filterControl.reductionSlider.getValue(),
-            filterControl.frequencySlider.getValue(),
-            filterControl.hysteresisSlider.getValue()
-        );
-        DBG("Hysteresis Slider Changed: " << filterControl.hysteresisSlider.getValue() << " dB");
-    };
-
-    setSize(1200, 800);
-    
-    formatManager.registerBasicFormats();
-    transportSource.addChangeListener(this);
-
-    setAudioChannels(2, 2);
-}
-
-MainComponent::~MainComponent()
-{
-    shutdownAudio();
-}
-
-void MainComponent::prepareToPlay(int samplesPerBlockExpected, double sampleRate)
-{
-    transportSource.prepareToPlay(samplesPerBlockExpected, sampleRate);
-    int numChannels = deviceManager.getCurrentAudioDevice()->getActiveInputChannels().countNumberOfSetBits();
-
-    processorManager.prepare(sampleRate, samplesPerBlockExpected, numChannels);
-    DBG("ProcessorManager prepared with sample rate: " << sampleRate
-            << ", block size: " << samplesPerBlockExpected
-            << ", num channels: " << numChannels);
-}
-
-void MainComponent::getNextAudioBlock(const juce::AudioSourceChannelInfo& bufferToFill)
-{
-    if (readerSource.get() == nullptr)
-    {
-        bufferToFill.clearActiveBufferRegion();
-    }
-    else
-    {
-        transportSource.getNextAudioBlock(bufferToFill);
-        processorManager.processBlock(*bufferToFill.buffer);
-    }
-}
-
-void MainComponent::releaseResources()
-{
-    transportSource.releaseResources();
-}
-
-
-void MainComponent::resized()
-{
-    auto bounds = getLocalBounds();
-    
-    // Define height proportions
-    const int topSectionHeight = bounds.getHeight() / 16;
-    const int middleSectionHeight = bounds.getHeight() / 2;
-    const int transportSectionHeight = bounds.getHeight() / 16;
-//    const int bottomSectionHeight = bounds.getHeight() / 4;
-
-    // Top section: File name, Open button, Export button
-    juce::FlexBox topSection;
-    topSection.flexDirection = juce::FlexBox::Direction::row;
-    topSection.items.add(juce::FlexItem(fileLabel).withFlex(1.0f));
-    topSection.items.add(juce::FlexItem(openButton).withFlex(0.5f));
-    topSection.performLayout(bounds.removeFromTop(topSectionHeight));
-
-    // Middle section layout: Waveform + Overlay
-    auto middleSectionBounds = bounds.removeFromTop(middleSectionHeight);
-    waveformDisplay.setBounds(middleSectionBounds);
-    positionOverlay.setBounds(middleSectionBounds);
-
-    // Transport controls
-    juce::FlexBox transportSection;
-    transportSection.flexDirection = juce::FlexBox::Direction::row;
-    transportSection.justifyContent = juce::FlexBox::JustifyContent::spaceAround;
-    transportSection.items.add(juce::FlexItem(playButton).withFlex(1.0f));
-    transportSection.items.add(juce::FlexItem(stopButton).withFlex(1.0f));
-    transportSection.performLayout(bounds.removeFromTop(transportSectionHeight));
-
-    // Bottom section: Filter controls and algorithm selector
-    juce::FlexBox bottomSection;
-    bottomSection.flexDirection = juce::FlexBox::Direction::column;
-    bottomSection.items.add(juce::FlexItem(filterControl).withFlex(1.0f));  // Filter controls
-    bottomSection.items.add(juce::FlexItem(algorithmSelector).withFlex(1.0f));  // Algorithm selector
-    bottomSection.performLayout(bounds);
-}
-
-void MainComponent::changeListenerCallback(juce::ChangeBroadcaster* source)
-{
-    if (source == &transportSource)
-        transportSourceChanged();
-}
-
-void MainComponent::changeState(TransportState newState)
-{
-    if (state != newState)
-    {
-        state = newState;
-
-        switch (state)
-        {
-            case Stopped:
-                stopButton.setEnabled(false);
-                playButton.setEnabled(true);
-                transportSource.setPosition(0.0);
-                break;
-
-            case Starting:
-                playButton.setEnabled(false);
-                transportSource.start();
-                break;
-
-            case Playing:
-                stopButton.setEnabled(true);
-                break;
-
-            case Stopping:
-                transportSource.stop();
-                break;
-
-            default:
-                jassertfalse;
-                break;
-        }
-    }
-}
-
-void MainComponent::transportSourceChanged()
-{
-    if (transportSource.isPlaying())
-        changeState(Playing);
-    else
-        changeState(Stopped);
-}
-
-void MainComponent::openButtonClicked()
-{
-    chooser = std::make_unique<juce::FileChooser> ("Select a Wave file to play...",
-                                                   juce::File{},
-                                                   "*.wav");
-    auto chooserFlags = juce::FileBrowserComponent::openMode
-                      | juce::FileBrowserComponent::canSelectFiles;
-
-    chooser->launchAsync (chooserFlags, [this] (const juce::FileChooser& fc)
-    {
-        auto file = fc.getResult();
-
-        if (file != juce::File{})
-        {
-            auto* reader = formatManager.createReaderFor (file);
-            fileLabel.setText(file.getFileName(), juce::dontSendNotification);
-
-            if (reader != nullptr)
-            {
-                auto newSource = std::make_unique<juce::AudioFormatReaderSource> (reader, true);
-                transportSource.setSource (newSource.get(), 0, nullptr, reader->sampleRate);
-                playButton.setEnabled (true);
-                waveformDisplay.setFile (file);
-                readerSource.reset (newSource.release());
-            }
-        }
-    });
-}
-
-void MainComponent::playButtonClicked()
-{
-    changeState(Starting);
-}
-
-void MainComponent::stopButtonClicked()
-{
-    changeState(Stopping);
-}
-
-
-
+#include "MainComponent.h"
+
+MainComponent::MainComponent()
+: state(Stopped),
+  waveformCache(5),
+waveformDisplay(512, formatManager, waveformCache),
+  positionOverlay(transportSource),
+  spectrumOverlay(spectrumFifo),
+  callbackLoadMeter(callbackLoad, deviceManager)
+{
+    addAndMakeVisible(&openButton);
+    openButton.setButtonText("Open...");
+    openButton.onClick = [this] { openButtonClicked(); };
+
+    addAndMakeVisible(&playButton);
+    playButton.setButtonText("Play");
+    playButton.onClick = [this] { playButtonClicked(); };
+    playButton.setColour(juce::TextButton::buttonColourId, juce::Colours::green);
+    playButton.setEnabled(false);
+
+    addAndMakeVisible(&stopButton);
+    stopButton.setButtonText("Stop");
+    stopButton.onClick = [this] { stopButtonClicked(); };
+    stopButton.setColour(juce::TextButton::buttonColourId, juce::Colours::red);
+    stopButton.setEnabled(false);
+
+    addAndMakeVisible(&nextSibilantButton);
+    nextSibilantButton.setButtonText("Next Sibilant");
+    nextSibilantButton.onClick = [this] { jumpToNextSibilant(); };
+    nextSibilantButton.setEnabled(false);
+
+    addAndMakeVisible(&exportButton);
+    exportButton.setButtonText("Export...");
+    exportButton.onClick = [this] { exportButtonClicked(); };
+    exportButton.setEnabled(false);
+
+    exportProgressBar.setTextToDisplay(juce::String());
+    addChildComponent(exportProgressBar);
+    
+    addAndMakeVisible(&waveformDisplay);
+    addAndMakeVisible(&positionOverlay);
+
+    // Zooming and scrolling happen in the waveform; the cursor follows it
+    positionOverlay.mouseWheelMoved = [this](const juce::MouseEvent& event, const juce::MouseWheelDetails& wheel)
+    {
+        waveformDisplay.mouseWheelMove(event.getEventRelativeTo(&waveformDisplay), wheel);
+    };
+
+    positionOverlay.mouseMagnified = [this](const juce::MouseEvent& event, float scaleFactor)
+    {
+        waveformDisplay.mouseMagnify(event.getEventRelativeTo(&waveformDisplay), scaleFactor);
+    };
+
+    waveformDisplay.visibleRangeChanged = [this](juce::Range<double> range)
+    {
+        positionOverlay.setVisibleRange(range);
+        updateThresholdPreview();
+    };
+    
+    addAndMakeVisible(algorithmSelector);
+    addAndMakeVisible(filterControl);
+    addAndMakeVisible(spectrumOverlay);
+    addAndMakeVisible(callbackLoadMeter);
+    
+    fileLabel.setText("No File Loaded", juce::dontSendNotification);
+    fileLabel.setJustificationType(juce::Justification::centredLeft);
+    addAndMakeVisible(fileLabel);
+
+    sessionList.setTextWhenNothingSelected("Session");
+    sessionList.setTextWhenNoChoicesAvailable("No files opened yet");
+    sessionList.onChange = [this] { sessionFileSelected(); };
+    addAndMakeVisible(sessionList);
+
+    underrunLabel.setJustificationType(juce::Justification::centredRight);
+    addAndMakeVisible(underrunLabel);
+
+    thresholdPreviewLabel.setJustificationType(juce::Justification::centred);
+    addAndMakeVisible(thresholdPreviewLabel);
+        
+
+    filterControl.frequencySlider.onValueChange = [this]()
+    {
+        pushDeEssingParameters();
+        spectrumOverlay.setCrossoverFrequency((float) filterControl.frequencySlider.getValue());
+        updateThresholdPreview();
+
+        DBG("Frequency Slider Changed: " << filterControl.frequencySlider.getValue() << " Hz");
+    };
+
+    filterControl.thresholdSlider.onValueChange = [this]()
+    {
+        pushDeEssingParameters();
+        updateThresholdPreview();
+
+        DBG("Threshold Slider Changed: " << filterControl.thresholdSlider.getValue() << " dB");
+    };
+
+    filterControl.reductionSlider.onValueChange = [this]()
+    {
+        pushDeEssingParameters();
+
+        DBG("Reduction Slider Changed: " << filterControl.reductionSlider.getValue() << " dB");
+    };
+    
+    filterControl.hysteresisSlider.onValueChange = [this]()
+    {
+        pushDeEssingParameters();
+        DBG("Hysteresis Slider Changed: " << filterControl.hysteresisSlider.getValue() << " dB");
+    };
+
+    algorithmSelector.algorithmChanged = [this]()
+    {
+        processorManager.setAlgorithm(algorithmSelector.getSelectedAlgorithm());
+    };
+
+    algorithmSelector.detectionChanged = [this]()
+    {
+        processorManager.setDetection(algorithmSelector.getDetection());
+    };
+
+    // Start the processor in sync with the sliders' initial positions
+    pushDeEssingParameters();
+    spectrumOverlay.setCrossoverFrequency((float) filterControl.frequencySlider.getValue());
+    processorManager.setSpectrumFifo(&spectrumFifo);
+
+    setSize(1200, 800);
+    
+    formatManager.registerBasicFormats();
+    transportSource.addChangeListener(this);
+    sibilantAnalyser.addChangeListener(this);
+    fileExporter.addChangeListener(this);
+
+    // Disk reads for playback happen here, never in the audio callback
+    readAheadThread.startThread(juce::Thread::Priority::high);
+    startTimerHz(4);
+
+    setAudioChannels(2, 2);
+}
+
+MainComponent::~MainComponent()
+{
+    fileExporter.removeChangeListener(this);
+    fileExporter.cancel();
+    shutdownAudio();
+    transportSource.setSource(nullptr);
+}
+
+void MainComponent::prepareToPlay(int samplesPerBlockExpected, double sampleRate)
+{
+    transportSource.prepareToPlay(samplesPerBlockExpected, sampleRate);
+    callbackLoad.prepare(sampleRate, samplesPerBlockExpected);
+    spectrumFifo.setSampleRate(sampleRate);
+
+    // The callback buffer carries as many channels as the wider of the active inputs and outputs
+    auto* device = deviceManager.getCurrentAudioDevice();
+    int numChannels = juce::jmax(device->getActiveInputChannels().countNumberOfSetBits(),
+                                 device->getActiveOutputChannels().countNumberOfSetBits());
+
+    processorManager.prepare(sampleRate, samplesPerBlockExpected, numChannels);
+    DBG("ProcessorManager prepared with sample rate: " << sampleRate
+            << ", block size: " << samplesPerBlockExpected
+            << ", num channels: " << numChannels);
+}
+
+void MainComponent::getNextAudioBlock(const juce::AudioSourceChannelInfo& bufferToFill)
+{
+    CallbackLoadMonitor::ScopedCallback callbackTiming(callbackLoad, bufferToFill.numSamples);
+
+    if (readerSource.get() == nullptr)
+    {
+        bufferToFill.clearActiveBufferRegion();
+    }
+    else
+    {
+        transportSource.getNextAudioBlock(bufferToFill);
+        processorManager.processBlock(*bufferToFill.buffer);
+    }
+}
+
+void MainComponent::pushDeEssingParameters()
+{
+    // Lock-free: the processor picks these up at its next block boundary
+    processorManager.setDeEssingParameters(
+        filterControl.thresholdSlider.getValue(),
+        filterControl.reductionSlider.getValue(),
+        filterControl.frequencySlider.getValue(),
+        filterControl.hysteresisSlider.getValue()
+    );
+
+    // The reduction doesn't change what counts as sibilant
+    sibilantAnalyser.setParameters((float) filterControl.thresholdSlider.getValue(),
+                                   (float) filterControl.frequencySlider.getValue(),
+                                   (int) filterControl.hysteresisSlider.getValue());
+}
+
+void MainComponent::releaseResources()
+{
+    transportSource.releaseResources();
+}
+
+
+void MainComponent::resized()
+{
+    auto bounds = getLocalBounds();
+    
+    // Define height proportions
+    const int topSectionHeight = bounds.getHeight() / 16;
+    const int middleSectionHeight = bounds.getHeight() / 2;
+    const int transportSectionHeight = bounds.getHeight() / 16;
+//    const int bottomSectionHeight = bounds.getHeight() / 4;
+
+    // Top section: File name, Open button, Export button
+    juce::FlexBox topSection;
+    topSection.flexDirection = juce::FlexBox::Direction::row;
+    topSection.items.add(juce::FlexItem(fileLabel).withFlex(1.0f));
+    topSection.items.add(juce::FlexItem(sessionList).withFlex(1.0f));
+    topSection.items.add(juce::FlexItem(underrunLabel).withFlex(0.5f));
+    topSection.items.add(juce::FlexItem(exportProgressBar).withFlex(0.5f));
+    topSection.items.add(juce::FlexItem(openButton).withFlex(0.5f));
+    topSection.items.add(juce::FlexItem(exportButton).withFlex(0.5f));
+    topSection.performLayout(bounds.removeFromTop(topSectionHeight));
+
+    // Middle section layout: Waveform + Overlay
+    auto middleSectionBounds = bounds.removeFromTop(middleSectionHeight);
+    waveformDisplay.setBounds(middleSectionBounds);
+    positionOverlay.setBounds(middleSectionBounds);
+
+    // Transport controls
+    juce::FlexBox transportSection;
+    transportSection.flexDirection = juce::FlexBox::Direction::row;
+    transportSection.justifyContent = juce::FlexBox::JustifyContent::spaceAround;
+    transportSection.items.add(juce::FlexItem(playButton).withFlex(1.0f));
+    transportSection.items.add(juce::FlexItem(stopButton).withFlex(1.0f));
+    transportSection.items.add(juce::FlexItem(nextSibilantButton).withFlex(1.0f));
+    transportSection.items.add(juce::FlexItem(thresholdPreviewLabel).withFlex(2.0f));
+    transportSection.performLayout(bounds.removeFromTop(transportSectionHeight));
+
+    // Bottom section: Filter controls and algorithm selector, spectrum on the right
+    spectrumOverlay.setBounds(bounds.removeFromRight(bounds.getWidth() / 3).reduced(10));
+
+    juce::FlexBox bottomSection;
+    bottomSection.flexDirection = juce::FlexBox::Direction::column;
+    bottomSection.items.add(juce::FlexItem(filterControl).withFlex(1.0f));  // Filter controls
+    bottomSection.items.add(juce::FlexItem(algorithmSelector).withFlex(1.0f));  // Algorithm selector
+    bottomSection.items.add(juce::FlexItem(callbackLoadMeter).withFlex(1.0f));  // Callback load
+    bottomSection.performLayout(bounds);
+}
+
+void MainComponent::updateThresholdPreview()
+{
+    const auto peaks = sibilantAnalyser.getBandPeaks();
+    const auto sampleRate = sibilantAnalyser.getSampleRate();
+
+    if (peaks == nullptr || sampleRate <= 0.0)
+    {
+        thresholdPreviewLabel.setText(audioFile != nullptr ? "Analysing sibilant band..." : juce::String(),
+                                      juce::dontSendNotification);
+        return;
+    }
+
+    // Sub-linear in the file length, so this keeps up with a slider drag
+    const auto threshold = juce::Decibels::decibelsToGain((float) filterControl.thresholdSlider.getValue());
+    const auto visible = waveformDisplay.getVisibleRange();
+    const auto flaggedInView = peaks->countFlaggedSamples((juce::int64) (visible.getStart() * sampleRate),
+                                                          (juce::int64) (visible.getEnd() * sampleRate),
+                                                          threshold);
+
+    auto text = "Flagged: " + juce::String(peaks->getFlaggedFraction(threshold) * 100.0, 1) + "% of file, "
+              + juce::String((double) flaggedInView / sampleRate, 2) + " s in view";
+
+    // Until the pass for a new frequency finishes, the old band stands in
+    if (peaks->getFrequency() != juce::jlimit(20.0f, (float) (sampleRate * 0.49), (float) filterControl.frequencySlider.getValue()))
+        text << " (updating)";
+
+    thresholdPreviewLabel.setText(text, juce::dontSendNotification);
+}
+
+void MainComponent::timerCallback()
+{
+    // Engines the audio thread has switched away from are freed here
+    processorManager.releaseRetiredEngine();
+
+    const int underruns = readerSource != nullptr ? readerSource->getNumUnderruns() : 0;
+
+    if (underruns != displayedUnderruns)
+    {
+        displayedUnderruns = underruns;
+        underrunLabel.setText("Read-ahead underruns: " + juce::String(underruns), juce::dontSendNotification);
+        underrunLabel.setColour(juce::Label::textColourId, underruns > 0 ? juce::Colours::orange : juce::Colours::grey);
+    }
+
+    // Set by prepare() on the audio side, so polled rather than pushed
+    const int latency = processorManager.getLatencySamples();
+    auto* device = deviceManager.getCurrentAudioDevice();
+    const double sampleRate = device != nullptr ? device->getCurrentSampleRate() : 0.0;
+
+    if (latency != displayedLatency || sampleRate != displayedLatencySampleRate)
+    {
+        displayedLatency = latency;
+        displayedLatencySampleRate = sampleRate;
+        algorithmSelector.setLatency(latency, sampleRate);
+    }
+
+    if (fileExporter.isExporting())
+        exportProgress = fileExporter.getProgress();
+}
+
+void MainComponent::changeListenerCallback(juce::ChangeBroadcaster* source)
+{
+    if (source == &transportSource)
+        transportSourceChanged();
+    else if (source == &sibilantAnalyser)
+    {
+        waveformDisplay.setSibilantRegions(sibilantAnalyser.getIndex());
+        updateThresholdPreview();
+    }
+    else if (source == &fileExporter)
+        exportFinished();
+}
+
+void MainComponent::changeState(TransportState newState)
+{
+    if (state != newState)
+    {
+        state = newState;
+
+        switch (state)
+        {
+            case Stopped:
+                stopButton.setEnabled(false);
+                playButton.setEnabled(true);
+                transportSource.setPosition(0.0);
+                break;
+
+            case Starting:
+                playButton.setEnabled(false);
+                transportSource.start();
+                break;
+
+            case Playing:
+                stopButton.setEnabled(true);
+                break;
+
+            case Stopping:
+                transportSource.stop();
+                break;
+
+            default:
+                jassertfalse;
+                break;
+        }
+    }
+}
+
+void MainComponent::transportSourceChanged()
+{
+    if (transportSource.isPlaying())
+        changeState(Playing);
+    else
+        changeState(Stopped);
+}
+
+void MainComponent::openButtonClicked()
+{
+    chooser = std::make_unique<juce::FileChooser> ("Select audio files to open...",
+                                                   juce::File{},
+                                                   formatManager.getWildcardForAllFormats());
+    auto chooserFlags = juce::FileBrowserComponent::openMode
+                      | juce::FileBrowserComponent::canSelectFiles
+                      | juce::FileBrowserComponent::canSelectMultipleItems;
+
+    chooser->launchAsync (chooserFlags, [this] (const juce::FileChooser& fc)
+    {
+        const auto files = fc.getResults();
+
+        if (files.isEmpty())
+            return;
+
+        for (const auto& file : files)
+        {
+            if (! sessionFiles.contains (file))
+            {
+                sessionFiles.add (file);
+                sessionList.addItem (file.getFileName(), sessionFiles.size());
+            }
+        }
+
+        // Opens the first one chosen, through sessionFileSelected()
+        sessionList.setSelectedItemIndex (sessionFiles.indexOf (files.getFirst()));
+    });
+}
+
+void MainComponent::sessionFileSelected()
+{
+    const auto index = sessionList.getSelectedItemIndex();
+
+    if (! juce::isPositiveAndBelow (index, sessionFiles.size()))
+        return;
+
+    loadFile (sessionFiles[index]);
+
+    // Most likely opened next; the previous take is usually still cached
+    if (index + 1 < sessionFiles.size())
+        decodedAudioCache.prefetch (sessionFiles[index + 1]);
+}
+
+void MainComponent::loadFile(const juce::File& file)
+{
+    if (audioFile != nullptr && audioFile->getFile() == file)
+        return;
+
+    // Playback, the waveform and the pyramid all read one mapping or one
+    // decoded copy; only playback drives the prefetch
+    auto newFile = std::make_unique<MappedAudioFile> (formatManager, file, &decodedAudioCache);
+    auto* reader = newFile->createReader (true).release();
+    fileLabel.setText(file.getFileName(), juce::dontSendNotification);
+
+    if (reader != nullptr)
+    {
+        // Our own read-ahead rather than the transport's, for the underrun count
+        auto newSource = std::make_unique<ReadAheadAudioSource> (new juce::AudioFormatReaderSource (reader, true), true,
+                                                                 readAheadThread,
+                                                                 (int) (readAheadSeconds * reader->sampleRate),
+                                                                 (int) (prefillSeconds * reader->sampleRate),
+                                                                 juce::jmax (2, (int) reader->numChannels));
+        transportSource.setSource (newSource.get(), 0, nullptr, reader->sampleRate);
+        playButton.setEnabled (true);
+        waveformDisplay.setFile (*newFile);
+        sibilantAnalyser.setFile (*newFile);
+        nextSibilantButton.setEnabled (true);
+        exportButton.setEnabled (true);
+        readerSource.reset (newSource.release());
+        audioFile = std::move (newFile);
+    }
+}
+
+void MainComponent::exportButtonClicked()
+{
+    if (fileExporter.isExporting())
+    {
+        fileExporter.cancel();
+        return;
+    }
+
+    if (audioFile == nullptr)
+        return;
+
+    const auto inputFile = audioFile->getFile();
+    chooser = std::make_unique<juce::FileChooser> ("Export the de-essed file as...",
+                                                   inputFile.getSiblingFile (inputFile.getFileNameWithoutExtension() + "_deessed.wav"),
+                                                   "*.wav");
+    auto chooserFlags = juce::FileBrowserComponent::saveMode
+                      | juce::FileBrowserComponent::canSelectFiles
+                      | juce::FileBrowserComponent::warnAboutOverwriting;
+
+    chooser->launchAsync (chooserFlags, [this, inputFile] (const juce::FileChooser& fc)
+    {
+        const auto outputFile = fc.getResult();
+
+        if (outputFile == juce::File{})
+            return;
+
+        // The current sliders and algorithm, the same values playback uses
+        OfflineRenderer::Settings settings;
+        settings.threshold = (float) filterControl.thresholdSlider.getValue();
+        settings.mixLevel = (float) filterControl.reductionSlider.getValue();
+        settings.frequency = (float) filterControl.frequencySlider.getValue();
+        settings.hysteresis = (float) filterControl.hysteresisSlider.getValue();
+        settings.algorithm = algorithmSelector.getSelectedAlgorithm();
+        settings.detection = algorithmSelector.getDetection();
+        settings.writeOnBackgroundThread = true;
+
+        if (! fileExporter.start (inputFile, outputFile, settings))
+        {
+            juce::AlertWindow::showMessageBoxAsync (juce::MessageBoxIconType::WarningIcon, "Export",
+                                                    "Could not export to " + outputFile.getFullPathName());
+            return;
+        }
+
+        exportProgress = 0.0;
+        exportProgressBar.setTextToDisplay (juce::String());
+        exportProgressBar.setVisible (true);
+        exportButton.setButtonText ("Cancel Export");
+    });
+}
+
+void MainComponent::exportFinished()
+{
+    const auto result = fileExporter.getResult();
+    exportButton.setButtonText ("Export...");
+
+    if (result.wasSuccessful())
+    {
+        exportProgress = 1.0;
+        exportProgressBar.setTextToDisplay ("Exported " + fileExporter.getOutputFile().getFileName() + " ("
+                                            + juce::String (result.getSpeedFactor(), 1) + "x realtime)");
+    }
+    else
+    {
+        exportProgress = 0.0;
+        exportProgressBar.setTextToDisplay (result.errorMessage == "Cancelled" ? juce::String ("Export cancelled")
+                                                                                : "Export failed: " + result.errorMessage);
+    }
+}
+
+void MainComponent::playButtonClicked()
+{
+    changeState(Starting);
+}
+
+void MainComponent::stopButtonClicked()
+{
+    changeState(Stopping);
+}
+
+void MainComponent::jumpToNextSibilant()
+{
+    const auto sampleRate = sibilantAnalyser.getSampleRate();
+
+    if (sampleRate <= 0.0 || readerSource == nullptr)
+        return;
+
+    // In file samples: going through seconds truncates to the sample before
+    // the region we last jumped to, which would then be found again
+    const auto currentSample = readerSource->getNextReadPosition();
+
+    if (auto* region = sibilantAnalyser.getIndex()->findNextAfter(currentSample))
+    {
+        const auto time = (double) region->startSample / sampleRate;
+        transportSource.setPosition(time);
+
+        // The transport's rate conversion can land a sample short; this seek
+        // stays inside what was just buffered
+        readerSource->setNextReadPosition(region->startSample);
+
+        // Bring it into view, keeping the zoom
+        const auto visible = waveformDisplay.getVisibleRange();
+
+        if (! visible.contains(time))
+            waveformDisplay.setVisibleRange(visible.movedToStartAt(time - visible.getLength() * 0.25));
+    }
+}
+
+
+
@@ -1,65 +1,117 @@
-#pragma once
-
-#include <JuceHeader.h>
-#include "AlgorithmSelector.h"
-#include "FilterControl.h"
-#include "WaveformDisplay.h"
-#include "PositionOverlay.h"
-//#include "MixerControl.h"
-#include "AudioProcessorManager.h"
-#include "Algorithms.h"
-
-class MainComponent : public juce::AudioAppComponent, public juce::ChangeListener
-{
-public:
-    MainComponent();
-    ~MainComponent() override;
-
-    void prepareToPlay(int samplesPerBlockExpected, double sampleRate) override;
-    void getNextAudioBlock(const juce::AudioSourceChannelInfo& bufferToFill) override;
-    void releaseResources() override;
-    void resized() override;
-    
-    void changeListenerCallback(juce::ChangeBroadcaster* source) override;
-
-//    void paint(juce::Graphics& g) override;
-
-
-private:
-    enum TransportState
-    {
-        Stopped,
-        Starting,
-        Playing,
-        Stopping
-    };
-    void changeState(TransportState newState);
-    void transportSourceChanged();
-    void openButtonClicked();
-    void playButtonClicked();
-    void stopButtonClicked();
-    
-    juce::TextButton openButton;
-    juce::TextButton playButton;
-    juce::TextButton stopButton;
-    
-    std::unique_ptr<juce::FileChooser> chooser;
-
-    juce::AudioFormatManager formatManager;
-    std::unique_ptr<juce::AudioFormatReaderSource> readerSource;
-    juce::AudioTransportSource transportSource;
-    TransportState state;
-    juce::AudioThumbnailCache waveformCache;
-    WaveformDisplay waveformDisplay;
-    PositionOverlay positionOverlay;
-    
-    juce::Label fileLabel;
-    
-    AlgorithmSelector algorithmSelector;
-    FilterControl filterControl;
-    
-    AudioProcessorManager processorManager;
-
-
-    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (MainComponent)
-};
+#pragma once
+
+#include <JuceHeader.h>
+#include "AlgorithmSelector.h"
+#include "FilterControl.h"
+#include "WaveformDisplay.h"
+#include "PositionOverlay.h"
+#include "SpectrumOverlay.h"
+//#include "MixerControl.h"
+#include "AudioProcessorManager.h"
+#include "CallbackLoadMeter.h"
+#include "DecodedAudioCache.h"
+#include "FileExporter.h"
+#include "MappedAudioFile.h"
+#include "ReadAheadAudioSource.h"
+#include "SibilantAnalyser.h"
+
+class MainComponent : public juce::AudioAppComponent, public juce::ChangeListener, private juce::Timer
+{
+public:
+    MainComponent();
+    ~MainComponent() override;
+
+    void prepareToPlay(int samplesPerBlockExpected, double sampleRate) override;
+    void getNextAudioBlock(const juce::AudioSourceChannelInfo& bufferToFill) override;
+    void releaseResources() override;
+    void resized() override;
+    
+    void changeListenerCallback(juce::ChangeBroadcaster* source) override;
+
+//    void paint(juce::Graphics& g) override;
+
+
+private:
+    enum TransportState
+    {
+        Stopped,
+        Starting,
+        Playing,
+        Stopping
+    };
+    void changeState(TransportState newState);
+    void transportSourceChanged();
+    void openButtonClicked();
+    void loadFile(const juce::File& file);
+    void sessionFileSelected();
+    void exportButtonClicked();
+    void exportFinished();
+    void playButtonClicked();
+    void stopButtonClicked();
+    void jumpToNextSibilant();
+    void updateThresholdPreview();
+    void pushDeEssingParameters();
+    void timerCallback() override;
+
+    // Playback read-ahead: how much is buffered, and how much a seek refills before returning
+    static constexpr double readAheadSeconds = 2.0;
+    static constexpr double prefillSeconds = 0.1;
+
+    // Decoded takes kept in memory; about an hour of stereo at 48 kHz
+    static constexpr size_t decodedCacheBytes = (size_t) 1 << 30;
+    
+    juce::TextButton openButton;
+    juce::TextButton playButton;
+    juce::TextButton stopButton;
+    juce::TextButton nextSibilantButton;
+    juce::TextButton exportButton;
+    
+    std::unique_ptr<juce::FileChooser> chooser;
+
+    juce::AudioFormatManager formatManager;
+    DecodedAudioCache decodedAudioCache { formatManager, decodedCacheBytes };
+    std::unique_ptr<MappedAudioFile> audioFile;
+    juce::TimeSliceThread readAheadThread { "Playback read-ahead" };
+    std::unique_ptr<ReadAheadAudioSource> readerSource;
+    juce::AudioTransportSource transportSource;
+    TransportState state;
+    PersistentThumbnailCache waveformCache;
+    WaveformDisplay waveformDisplay;
+    PositionOverlay positionOverlay;
+    SibilantAnalyser sibilantAnalyser;
+    
+    juce::Label fileLabel;
+
+    // Every file opened this session, in the order opened; the one after the
+    // current take is decoded ahead
+    juce::ComboBox sessionList;
+    juce::Array<juce::File> sessionFiles;
+
+    juce::Label underrunLabel;
+    juce::Label thresholdPreviewLabel;
+    int displayedUnderruns = -1;
+    int displayedLatency = -1;
+    double displayedLatencySampleRate = 0.0;
+
+    // Polled from the exporter by the timer
+    double exportProgress = 0.0;
+    juce::ProgressBar exportProgressBar { exportProgress };
+    
+    AlgorithmSelector algorithmSelector;
+    FilterControl filterControl;
+
+    // The FIFO is fed by processorManager and must outlive the overlay reading it
+    SpectrumFifo spectrumFifo;
+    SpectrumOverlay spectrumOverlay;
+    
+    AudioProcessorManager processorManager;
+
+    // Written by the audio callback, shown by the meter
+    CallbackLoadMonitor callbackLoad;
+    CallbackLoadMeter callbackLoadMeter;
+
+    FileExporter fileExporter;
+
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (MainComponent)
+};
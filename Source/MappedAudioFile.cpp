@@ -0,0 +1,285 @@
+/*
+  ==============================================================================
+
+    MappedAudioFile.cpp
+    Created: 17 Oct 2026 11:08:15pm
+    Author:  Leif Rehtanz
+
+  ==============================================================================
+*/
+
+#include "MappedAudioFile.h"
+
+// Owns the mapping and the prefetch thread; kept alive by every reader using it.
+// The thread only starts once a reader asks for prefetching, and sleeps
+// whenever that reader stops moving, e.g. while playback is paused.
+class MappedAudioFile::SharedMapping : private juce::Thread
+{
+public:
+    explicit SharedMapping(std::unique_ptr<juce::MemoryMappedAudioFormatReader> mappedReader)
+        : juce::Thread("Audio file prefetch"),
+          reader(std::move(mappedReader))
+    {
+        const auto bytesPerFrame = juce::jmax(1, (int) reader->numChannels * (int) reader->bitsPerSample / 8);
+        samplesPerPage = juce::jmax(1, pageSize / bytesPerFrame);
+        prefetchSamples = (juce::int64) (reader->sampleRate * prefetchSeconds);
+    }
+
+    ~SharedMapping() override
+    {
+        signalThreadShouldExit();
+        notify();
+        stopThread(1000);
+    }
+
+    void startPrefetching()
+    {
+        std::call_once(prefetchStarted, [this] { startThread(juce::Thread::Priority::low); });
+    }
+
+    // Lock-free unless the prefetch thread is asleep, which only wakes it
+    // once when a paused play head moves again
+    void setReadPosition(juce::int64 position) noexcept
+    {
+        readPosition.store(position);
+
+        if (isIdle.exchange(false))
+            notify();
+    }
+
+    juce::MemoryMappedAudioFormatReader& getReader() noexcept  { return *reader; }
+
+private:
+    static constexpr int pageSize = 4096;
+    static constexpr double prefetchSeconds = 5.0;
+
+    // The madvise(MADV_WILLNEED) idea done portably: the reader's mapping is
+    // private, but touching one sample per page faults the pages in here
+    // instead of in the reader's thread
+    void run() override
+    {
+        juce::int64 prefetchedStart = 0, prefetchedEnd = 0;
+
+        while (! threadShouldExit())
+        {
+            const auto position = readPosition.load();
+
+            if (position >= 0)
+            {
+                // A seek outside the window starts a new one
+                if (position < prefetchedStart || position > prefetchedEnd)
+                    prefetchedStart = prefetchedEnd = position;
+
+                const auto target = juce::jmin(reader->lengthInSamples, position + prefetchSamples);
+
+                for (; prefetchedEnd < target && ! threadShouldExit(); prefetchedEnd += samplesPerPage)
+                    reader->touchSample(prefetchedEnd);
+            }
+
+            wait(20);
+
+            // Nothing read since the last pass: sleep until the next read. The
+            // second check catches a read that came before isIdle was set.
+            if (readPosition.load() == position)
+            {
+                isIdle.store(true);
+
+                if (readPosition.load() == position)
+                    wait(-1);
+            }
+        }
+    }
+
+    std::unique_ptr<juce::MemoryMappedAudioFormatReader> reader;
+    std::atomic<juce::int64> readPosition { -1 };
+    std::atomic<bool> isIdle { false };
+    std::once_flag prefetchStarted;
+    int samplesPerPage = 1;
+    juce::int64 prefetchSamples = 0;
+};
+
+// Thin reader over the shared mapping. The mapped reader keeps no state
+// between reads, so any number of these can read from it concurrently.
+class MappedAudioFile::MappedReader : public juce::AudioFormatReader
+{
+public:
+    MappedReader(std::shared_ptr<SharedMapping> mappingToUse, bool shouldReportPosition)
+        : juce::AudioFormatReader(nullptr, mappingToUse->getReader().getFormatName()),
+          mapping(std::move(mappingToUse)),
+          reportsPosition(shouldReportPosition)
+    {
+        auto& source = mapping->getReader();
+        sampleRate = source.sampleRate;
+        bitsPerSample = source.bitsPerSample;
+        lengthInSamples = source.lengthInSamples;
+        numChannels = source.numChannels;
+        usesFloatingPointData = source.usesFloatingPointData;
+        metadataValues = source.metadataValues;
+    }
+
+    bool readSamples(int* const* destChannels, int numDestChannels, int startOffsetInDestBuffer,
+                     juce::int64 startSampleInFile, int numSamples) override
+    {
+        if (reportsPosition)
+            mapping->setReadPosition(startSampleInFile + numSamples);
+
+        return mapping->getReader().readSamples(destChannels, numDestChannels, startOffsetInDestBuffer,
+                                                startSampleInFile, numSamples);
+    }
+
+private:
+    std::shared_ptr<SharedMapping> mapping;
+    const bool reportsPosition;
+};
+
+// Reads the decoded samples, which it keeps alive; they never change, so any
+// number of these can read them concurrently
+class MappedAudioFile::DecodedReader : public juce::AudioFormatReader
+{
+public:
+    explicit DecodedReader(std::shared_ptr<const DecodedAudioCache::DecodedAudio> audioToRead)
+        : juce::AudioFormatReader(nullptr, audioToRead->formatName),
+          audio(std::move(audioToRead))
+    {
+        sampleRate = audio->sampleRate;
+        bitsPerSample = 32;
+        lengthInSamples = audio->samples.getNumSamples();
+        numChannels = (unsigned int) audio->samples.getNumChannels();
+        usesFloatingPointData = true;
+        metadataValues = audio->metadataValues;
+    }
+
+    bool readSamples(int* const* destChannels, int numDestChannels, int startOffsetInDestBuffer,
+                     juce::int64 startSampleInFile, int numSamples) override
+    {
+        clearSamplesBeyondAvailableLength(destChannels, numDestChannels, startOffsetInDestBuffer,
+                                          startSampleInFile, numSamples, lengthInSamples);
+
+        if (numSamples <= 0)
+            return true;
+
+        for (int channel = 0; channel < numDestChannels; ++channel)
+        {
+            if (auto* dest = reinterpret_cast<float*>(destChannels[channel]))
+            {
+                if (channel < audio->samples.getNumChannels())
+                    juce::FloatVectorOperations::copy(dest + startOffsetInDestBuffer,
+                                                      audio->samples.getReadPointer(channel, (int) startSampleInFile),
+                                                      numSamples);
+                else
+                    juce::FloatVectorOperations::clear(dest + startOffsetInDestBuffer, numSamples);
+            }
+        }
+
+        return true;
+    }
+
+private:
+    std::shared_ptr<const DecodedAudioCache::DecodedAudio> audio;
+};
+
+// Streams the file until the cache has decoded it, then reads the decoded
+// samples instead. Hands out floats either way, so nothing about it changes
+// when it switches.
+class MappedAudioFile::DecodingReader : public juce::AudioFormatReader
+{
+public:
+    DecodingReader(std::unique_ptr<juce::AudioFormatReader> streamingReader,
+                   std::shared_ptr<const DecodedAudioCache::PendingAudio> pendingAudio)
+        : juce::AudioFormatReader(nullptr, streamingReader->getFormatName()),
+          stream(std::move(streamingReader)),
+          pending(std::move(pendingAudio))
+    {
+        sampleRate = stream->sampleRate;
+        bitsPerSample = 32;
+        lengthInSamples = stream->lengthInSamples;
+        numChannels = stream->numChannels;
+        usesFloatingPointData = true;
+        metadataValues = stream->metadataValues;
+    }
+
+    bool readSamples(int* const* destChannels, int numDestChannels, int startOffsetInDestBuffer,
+                     juce::int64 startSampleInFile, int numSamples) override
+    {
+        if (decodedReader == nullptr)
+        {
+            if (auto audio = pending->getIfReady())
+            {
+                decodedReader = std::make_unique<DecodedReader>(std::move(audio));
+                stream.reset();
+            }
+        }
+
+        if (decodedReader != nullptr)
+            return decodedReader->readSamples(destChannels, numDestChannels, startOffsetInDestBuffer,
+                                              startSampleInFile, numSamples);
+
+        clearSamplesBeyondAvailableLength(destChannels, numDestChannels, startOffsetInDestBuffer,
+                                          startSampleInFile, numSamples, lengthInSamples);
+
+        if (numSamples <= 0)
+            return true;
+
+        channelPointers.resize((size_t) numDestChannels);
+
+        for (int channel = 0; channel < numDestChannels; ++channel)
+            channelPointers[(size_t) channel] = destChannels[channel] != nullptr
+                                                    ? reinterpret_cast<float*>(destChannels[channel]) + startOffsetInDestBuffer
+                                                    : nullptr;
+
+        return stream->read(channelPointers.data(), numDestChannels, startSampleInFile, numSamples);
+    }
+
+private:
+    std::unique_ptr<juce::AudioFormatReader> stream;
+    std::shared_ptr<const DecodedAudioCache::PendingAudio> pending;
+    std::unique_ptr<DecodedReader> decodedReader;
+    std::vector<float*> channelPointers;
+};
+
+MappedAudioFile::MappedAudioFile(juce::AudioFormatManager& formatManagerToUse, const juce::File& fileToOpen,
+                                 DecodedAudioCache* decodedAudioCache)
+    : formatManager(formatManagerToUse),
+      file(fileToOpen)
+{
+    for (auto* format : formatManager)
+    {
+        if (! format->canHandleFile(file))
+            continue;
+
+        std::unique_ptr<juce::MemoryMappedAudioFormatReader> mappedReader(format->createMemoryMappedReader(file));
+
+        if (mappedReader != nullptr && mappedReader->mapEntireFile())
+        {
+            mapping = std::make_shared<SharedMapping>(std::move(mappedReader));
+            break;
+        }
+    }
+
+    if (mapping == nullptr && decodedAudioCache != nullptr)
+        decoded = decodedAudioCache->get(file);
+}
+
+std::unique_ptr<juce::AudioFormatReader> MappedAudioFile::createReader(bool prefetchAheadOfReads) const
+{
+    if (mapping != nullptr)
+    {
+        if (prefetchAheadOfReads)
+            mapping->startPrefetching();
+
+        return std::make_unique<MappedReader>(mapping, prefetchAheadOfReads);
+    }
+
+    // Already in memory, so there's nothing to prefetch
+    if (decoded != nullptr)
+        if (auto audio = decoded->getIfReady())
+            return std::make_unique<DecodedReader>(std::move(audio));
+
+    // Compressed or otherwise unmappable: stream it, until the cache has it if it's decoding
+    std::unique_ptr<juce::AudioFormatReader> streamingReader(formatManager.createReaderFor(file));
+
+    if (streamingReader != nullptr && decoded != nullptr)
+        return std::make_unique<DecodingReader>(std::move(streamingReader), decoded);
+
+    return streamingReader;
+}
@@ -0,0 +1,57 @@
+/*
+  ==============================================================================
+
+    MappedAudioFile.h
+    Created: 17 Oct 2026 11:08:15pm
+    Author:  Leif Rehtanz
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "DecodedAudioCache.h"
+
+// One audio file opened for every part of the app that reads it: playback,
+// thumbnail generation, the waveform pyramid and offline rendering. Formats
+// that can be memory-mapped (uncompressed WAV and AIFF) are mapped once and
+// every reader handed out reads straight from that mapping, so reads are
+// plain memory copies with no file I/O or seeking, and all readers share the
+// same pages. Other formats are decoded once into a DecodedAudioCache when
+// one is given, and read from the decoded samples the same way; readers
+// stream the file until the cache's background thread is done and then
+// switch over, or for good if the file is too big for the cache. Without a
+// cache they fall back to a fresh streaming reader per call.
+class MappedAudioFile
+{
+public:
+    // Only asks the cache for the file; nothing is decoded on this thread
+    MappedAudioFile(juce::AudioFormatManager& formatManagerToUse, const juce::File& fileToOpen,
+                    DecodedAudioCache* decodedAudioCache = nullptr);
+
+    const juce::File& getFile() const noexcept   { return file; }
+    bool isMemoryMapped() const noexcept         { return mapping != nullptr; }
+    bool isDecoded() const                       { return decoded != nullptr && decoded->getIfReady() != nullptr; }
+
+    // Thread-safe; each reader may be used by one thread at a time, and they
+    // stay valid after this object is gone. Returns nullptr if the file can't
+    // be read. With prefetchAheadOfReads, a background thread touches the
+    // mapped pages ahead of wherever this reader last read, so a play head
+    // never waits for the disk; give it to the reader that streams in real
+    // time, not to ones that scan.
+    std::unique_ptr<juce::AudioFormatReader> createReader(bool prefetchAheadOfReads = false) const;
+
+private:
+    class SharedMapping;
+    class MappedReader;
+    class DecodedReader;
+    class DecodingReader;
+
+    juce::AudioFormatManager& formatManager;
+    const juce::File file;
+    std::shared_ptr<SharedMapping> mapping;
+    std::shared_ptr<const DecodedAudioCache::PendingAudio> decoded;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(MappedAudioFile)
+};
@@ -0,0 +1,190 @@
+/*
+  ==============================================================================
+
+    MultichannelLinkwitzRiley.cpp
+    Created: 17 Oct 2026 1:36:52pm
+    Author:  Leif Rehtanz
+
+  ==============================================================================
+*/
+
+#include "MultichannelLinkwitzRiley.h"
+
+MultichannelLinkwitzRiley::MultichannelLinkwitzRiley()
+{
+    update();
+}
+
+void MultichannelLinkwitzRiley::setCutoffFrequency(float newCutoffFrequencyHz)
+{
+    jassert(juce::isPositiveAndBelow(newCutoffFrequencyHz, (float) (sampleRate * 0.5)));
+
+    cutoffFrequency = newCutoffFrequencyHz;
+    update();
+}
+
+void MultichannelLinkwitzRiley::prepare(const juce::dsp::ProcessSpec& spec)
+{
+    jassert(spec.sampleRate > 0);
+
+    sampleRate = spec.sampleRate;
+    numChannels = spec.numChannels;
+    maxBlockSize = spec.maximumBlockSize;
+
+    const auto lanes = SIMDFloat::size();
+    numLaneGroups = (numChannels + lanes - 1) / lanes;
+
+    // One extra register's worth so all views can be snapped to SIMD alignment
+    const auto interleavedSize = maxBlockSize * lanes;
+    const auto stateSize = numLaneGroups * statesPerLane * lanes;
+    storage.allocate(2 * interleavedSize + stateSize + lanes, true);
+
+    interleavedData = SIMDFloat::getNextSIMDAlignedPtr(storage.get());
+    interleavedHighData = interleavedData + interleavedSize;
+    stateData = interleavedHighData + interleavedSize;
+
+    update();
+    reset();
+}
+
+void MultichannelLinkwitzRiley::reset()
+{
+    if (stateData != nullptr)
+        std::fill(stateData, stateData + getStateSize(), 0.0f);
+}
+
+void MultichannelLinkwitzRiley::copyStateTo(float* dest) const
+{
+    if (stateData != nullptr)
+        std::copy(stateData, stateData + getStateSize(), dest);
+}
+
+void MultichannelLinkwitzRiley::copyStateFrom(const float* source)
+{
+    if (stateData != nullptr)
+        std::copy(source, source + getStateSize(), stateData);
+}
+
+void MultichannelLinkwitzRiley::update()
+{
+    // Same coefficients as juce::dsp::LinkwitzRileyFilter, so the two are interchangeable
+    g  = (float) std::tan(juce::MathConstants<double>::pi * cutoffFrequency / sampleRate);
+    R2 = (float) std::sqrt(2.0);
+    h  = (float) (1.0 / (1.0 + R2 * g + g * g));
+}
+
+void MultichannelLinkwitzRiley::processCrossover(const juce::dsp::AudioBlock<const float>& input,
+                                                 juce::dsp::AudioBlock<float>& fullBand,
+                                                 juce::dsp::AudioBlock<float>& highBand)
+{
+    juce::ScopedNoDenormals noDenormals;
+
+    const auto blockChannels = input.getNumChannels();
+    const auto numSamples = input.getNumSamples();
+    const auto lanes = SIMDFloat::size();
+
+    jassert(blockChannels <= numChannels && numSamples <= maxBlockSize);
+    jassert(fullBand.getNumChannels() >= blockChannels && fullBand.getNumSamples() >= numSamples);
+    jassert(highBand.getNumChannels() >= blockChannels && highBand.getNumSamples() >= numSamples);
+
+    auto fullOut = fullBand.getSubsetChannelBlock(0, blockChannels).getSubBlock(0, numSamples);
+    auto highOut = highBand.getSubsetChannelBlock(0, blockChannels).getSubBlock(0, numSamples);
+
+    for (size_t group = 0; group * lanes < blockChannels; ++group)
+    {
+        interleave(input, group * lanes, numSamples, interleavedData);
+        processCrossoverLaneGroup(interleavedData, interleavedHighData, stateData + group * statesPerLane * lanes, numSamples);
+        deinterleave(interleavedData, group * lanes, numSamples, fullOut);
+        deinterleave(interleavedHighData, group * lanes, numSamples, highOut);
+    }
+}
+
+void MultichannelLinkwitzRiley::interleave(const juce::dsp::AudioBlock<const float>& block, size_t firstChannel,
+                                           size_t numSamples, float* dest) const
+{
+    const auto lanes = SIMDFloat::size();
+    const auto groupChannels = juce::jmin(lanes, block.getNumChannels() - firstChannel);
+
+    // One register per sample; lanes without a channel stay silent
+    for (size_t lane = 0; lane < lanes; ++lane)
+    {
+        if (lane < groupChannels)
+        {
+            const auto* src = block.getChannelPointer(firstChannel + lane);
+
+            for (size_t i = 0; i < numSamples; ++i)
+                dest[i * lanes + lane] = src[i];
+        }
+        else
+        {
+            for (size_t i = 0; i < numSamples; ++i)
+                dest[i * lanes + lane] = 0.0f;
+        }
+    }
+}
+
+void MultichannelLinkwitzRiley::deinterleave(const float* source, size_t firstChannel, size_t numSamples,
+                                             juce::dsp::AudioBlock<float>& block) const
+{
+    const auto lanes = SIMDFloat::size();
+    const auto groupChannels = juce::jmin(lanes, block.getNumChannels() - firstChannel);
+
+    for (size_t lane = 0; lane < groupChannels; ++lane)
+    {
+        auto* dest = block.getChannelPointer(firstChannel + lane);
+
+        for (size_t i = 0; i < numSamples; ++i)
+            dest[i] = source[i * lanes + lane];
+    }
+}
+
+void MultichannelLinkwitzRiley::processCrossoverLaneGroup(float* interleaved, float* interleavedHigh,
+                                                          float* state, size_t numSamples) const
+{
+    const auto lanes = SIMDFloat::size();
+
+    auto s1 = SIMDFloat::fromRawArray(state);
+    auto s2 = SIMDFloat::fromRawArray(state + lanes);
+    auto s3 = SIMDFloat::fromRawArray(state + 2 * lanes);
+    auto s4 = SIMDFloat::fromRawArray(state + 3 * lanes);
+
+    const auto vg  = SIMDFloat::expand(g);
+    const auto vR2 = SIMDFloat::expand(R2);
+    const auto vh  = SIMDFloat::expand(h);
+    const auto vR2g = SIMDFloat::expand(R2 + g);
+
+    for (size_t i = 0; i < numSamples; ++i)
+    {
+        auto* frame = interleaved + i * lanes;
+        const auto x = SIMDFloat::fromRawArray(frame);
+
+        // Shared first stage gives the second-order all-pass directly...
+        const auto yH = (x - vR2g * s1 - s2) * vh;
+
+        const auto yB = vg * yH + s1;
+        s1 = vg * yH + yB;
+
+        const auto yL = vg * yB + s2;
+        s2 = vg * yB + yL;
+
+        const auto allPass = yL - vR2 * yB + yH;
+
+        // ...and a second low-pass stage gives the fourth-order low band. Since
+        // LP4 + HP4 equals that all-pass, the high band is the difference.
+        const auto yH2 = (yL - vR2g * s3 - s4) * vh;
+
+        const auto yB2 = vg * yH2 + s3;
+        s3 = vg * yH2 + yB2;
+
+        const auto yL2 = vg * yB2 + s4;
+        s4 = vg * yB2 + yL2;
+
+        allPass.copyToRawArray(frame);
+        (allPass - yL2).copyToRawArray(interleavedHigh + i * lanes);
+    }
+
+    s1.copyToRawArray(state);
+    s2.copyToRawArray(state + lanes);
+    s3.copyToRawArray(state + 2 * lanes);
+    s4.copyToRawArray(state + 3 * lanes);
+}
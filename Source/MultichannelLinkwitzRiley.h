@@ -0,0 +1,113 @@
+/*
+  ==============================================================================
+
+    MultichannelLinkwitzRiley.h
+    Created: 17 Oct 2026 1:36:52pm
+    Author:  Leif Rehtanz
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+// The de-esser's band split: a fourth-order Linkwitz-Riley crossover, with
+// the same topology and coefficients as juce::dsp::LinkwitzRileyFilter<float>,
+// that yields the high band and the phase-aligned full band in one pass.
+// Channels are filtered side by side: each SIMD register carries one sample
+// from SIMDRegister<float>::size() channels (4 with SSE/NEON, 8 with AVX), so
+// a 12-channel bed costs three filter passes on SSE instead of twelve.
+class MultichannelLinkwitzRiley
+{
+public:
+    MultichannelLinkwitzRiley();
+
+    void setCutoffFrequency(float newCutoffFrequencyHz);
+    float getCutoffFrequency() const noexcept { return cutoffFrequency; }
+
+    // Allocates the interleaved scratch block and the filter state
+    void prepare(const juce::dsp::ProcessSpec& spec);
+    void reset();
+
+    // Raw copies of the filter state, so that another instance prepared with
+    // the same spec and cutoff can carry on exactly where this one stopped
+    size_t getStateSize() const noexcept   { return numLaneGroups * statesPerLane * SIMDFloat::size(); }
+    void copyStateTo(float* dest) const;
+    void copyStateFrom(const float* source);
+
+    // Complementary crossover in a single pass over the input, sharing one set
+    // of state: highBand receives the fourth-order high band and fullBand the
+    // phase-aligned sum of both bands (the second-order all-pass response), so
+    // the low band is fullBand - highBand. Real-time safe. The input may have
+    // fewer channels and samples than prepared for, never more, and the
+    // outputs must not alias it.
+    void processCrossover(const juce::dsp::AudioBlock<const float>& input,
+                          juce::dsp::AudioBlock<float>& fullBand,
+                          juce::dsp::AudioBlock<float>& highBand);
+
+    // processCrossover() for a layout fixed at compile time, on raw channel
+    // pointers: NumChannels must fit one SIMD register, and BlockSize is the
+    // exact sample count, or 0 to take numSamples instead. Fixed bounds let
+    // the compiler unroll and vectorise the interleaving; the filtering and
+    // so the output are the same as the generic version's.
+    template <int NumChannels, int BlockSize>
+    void processCrossover(const float* const* input, float* const* fullBand, float* const* highBand, int numSamples);
+
+private:
+    using SIMDFloat = juce::dsp::SIMDRegister<float>;
+    static constexpr size_t statesPerLane = 4;
+
+    void update();
+    void processCrossoverLaneGroup(float* interleaved, float* interleavedHigh, float* state, size_t numSamples) const;
+
+    void interleave(const juce::dsp::AudioBlock<const float>& block, size_t firstChannel, size_t numSamples, float* dest) const;
+    void deinterleave(const float* source, size_t firstChannel, size_t numSamples, juce::dsp::AudioBlock<float>& block) const;
+
+    float cutoffFrequency = 2000.0f;
+    double sampleRate = 44100.0;
+    float g = 0.0f, R2 = 0.0f, h = 0.0f;
+
+    size_t numChannels = 0;
+    size_t numLaneGroups = 0;
+    size_t maxBlockSize = 0;
+
+    // SIMD-aligned views into storage
+    juce::HeapBlock<float> storage;
+    float* interleavedData = nullptr;
+    float* interleavedHighData = nullptr;
+    float* stateData = nullptr;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(MultichannelLinkwitzRiley)
+};
+
+template <int NumChannels, int BlockSize>
+void MultichannelLinkwitzRiley::processCrossover(const float* const* input, float* const* fullBand,
+                                                 float* const* highBand, int numSamples)
+{
+    constexpr auto lanes = SIMDFloat::size();
+    static_assert(NumChannels > 0 && (size_t) NumChannels <= lanes, "The channels must fit one lane group");
+    static_assert(BlockSize >= 0, "BlockSize is a sample count, or 0 for numSamples");
+
+    juce::ScopedNoDenormals noDenormals;
+
+    const auto count = (size_t) (BlockSize > 0 ? BlockSize : numSamples);
+    jassert(BlockSize == 0 || numSamples == BlockSize);
+    jassert((size_t) NumChannels <= numChannels && count <= maxBlockSize);
+
+    // Lanes without a channel stay silent, as in interleave()
+    for (size_t i = 0; i < count; ++i)
+        for (size_t lane = 0; lane < lanes; ++lane)
+            interleavedData[i * lanes + lane] = lane < (size_t) NumChannels ? input[lane][i] : 0.0f;
+
+    processCrossoverLaneGroup(interleavedData, interleavedHighData, stateData, count);
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        for (size_t channel = 0; channel < (size_t) NumChannels; ++channel)
+        {
+            fullBand[channel][i] = interleavedData[i * lanes + channel];
+            highBand[channel][i] = interleavedHighData[i * lanes + channel];
+        }
+    }
+}
@@ -0,0 +1,401 @@
+/*
+  ==============================================================================
+
+    OfflineRenderer.cpp
+    Created: 17 Oct 2026 3:20:11pm
+    Author:  Leif Rehtanz
+
+  ==============================================================================
+*/
+
+#include "OfflineRenderer.h"
+#include "DoubleBufferedWriter.h"
+#include "MappedAudioFile.h"
+#include <thread>
+
+namespace
+{
+    void prepareProcessor(AudioProcessorManager& processor, const OfflineRenderer::Settings& settings,
+                          double sampleRate, int numChannels)
+    {
+        processor.setDeEssingParameters(settings.threshold, settings.mixLevel, settings.frequency, settings.hysteresis);
+        processor.setAlignsLatencies(false);
+        processor.setAlgorithm(settings.algorithm);
+        processor.setDetection(settings.detection);
+        processor.prepare(sampleRate, juce::jmax(1, settings.blockSize), numChannels);
+    }
+
+    // One per thread, reused for every chunk that thread renders
+    struct ChunkRenderer
+    {
+        std::unique_ptr<juce::AudioFormatReader> reader;
+        AudioProcessorManager processor;
+
+        // Pre-roll followed by the chunk itself; rendered in place
+        juce::AudioBuffer<float> buffer;
+        juce::int64 startSample = 0;
+        int preRollSamples = 0;
+        int numSamples = 0;
+
+        // State after the pre-roll, and after each block of the chunk
+        AudioProcessorManager::State startState;
+        std::vector<AudioProcessorManager::State> blockEndStates;
+        bool readSucceeded = true;
+    };
+
+    // Processes part of a buffer in place without copying it out
+    void processRange(AudioProcessorManager& processor, juce::AudioBuffer<float>& buffer, int startSample, int numSamples)
+    {
+        juce::AudioBuffer<float> range(buffer.getArrayOfWritePointers(), buffer.getNumChannels(), startSample, numSamples);
+        processor.processBlock(range);
+    }
+
+    void renderChunk(ChunkRenderer& chunk, const OfflineRenderer::Settings& settings)
+    {
+        auto& reader = *chunk.reader;
+        const int numChannels = (int) reader.numChannels;
+        const int totalSamples = chunk.preRollSamples + chunk.numSamples;
+        const int blockSize = juce::jmax(1, settings.blockSize);
+
+        // Preparing again puts the processor back into its cold initial state
+        prepareProcessor(chunk.processor, settings, reader.sampleRate, numChannels);
+
+        chunk.buffer.setSize(numChannels, totalSamples, false, false, true);
+        chunk.blockEndStates.clear();
+        chunk.readSucceeded = reader.read(&chunk.buffer, 0, totalSamples, chunk.startSample - chunk.preRollSamples, true, true);
+
+        if (! chunk.readSucceeded)
+            return;
+
+        processRange(chunk.processor, chunk.buffer, 0, chunk.preRollSamples);
+        chunk.startState = chunk.processor.getState();
+
+        for (int offset = 0; offset < chunk.numSamples; offset += blockSize)
+        {
+            processRange(chunk.processor, chunk.buffer, chunk.preRollSamples + offset, juce::jmin(blockSize, chunk.numSamples - offset));
+            chunk.blockEndStates.push_back(chunk.processor.getState());
+        }
+    }
+}
+
+namespace
+{
+    OfflineRenderer::BlockWriter writeTo(juce::AudioFormatWriter& writer)
+    {
+        return [&writer] (const juce::AudioBuffer<float>& buffer, int startSample, int numSamples)
+        {
+            return writer.writeFromAudioSampleBuffer(buffer, startSample, numSamples);
+        };
+    }
+}
+
+OfflineRenderer::Result OfflineRenderer::render(juce::AudioFormatReader& reader,
+                                                juce::AudioFormatWriter& writer,
+                                                const Settings& settings,
+                                                const ProgressCallback& progressCallback)
+{
+    return render(reader, writeTo(writer), settings, progressCallback);
+}
+
+OfflineRenderer::Result OfflineRenderer::renderChunked(const ReaderFactory& createReader,
+                                                       juce::AudioFormatWriter& writer,
+                                                       const Settings& settings,
+                                                       const ProgressCallback& progressCallback)
+{
+    return renderChunked(createReader, writeTo(writer), settings, progressCallback);
+}
+
+OfflineRenderer::Result OfflineRenderer::render(juce::AudioFormatReader& reader,
+                                                const BlockWriter& writeBlock,
+                                                const Settings& settings,
+                                                const ProgressCallback& progressCallback)
+{
+    Result result;
+    result.sampleRate = reader.sampleRate;
+    result.numSamples = reader.lengthInSamples;
+
+    const int numChannels = (int) reader.numChannels;
+    const int blockSize = juce::jmax(1, settings.blockSize);
+
+    if (numChannels <= 0 || reader.sampleRate <= 0.0)
+    {
+        result.errorMessage = "Unsupported input format";
+        return result;
+    }
+
+    prepareProcessor(processor, settings, reader.sampleRate, numChannels);
+
+    buffer.setSize(numChannels, blockSize, false, false, true);
+    const auto startTicks = juce::Time::getHighResolutionTicks();
+
+    // Engines with latency run on past the end, reading silence, and their
+    // first latency samples are dropped, so the output lines up with the input
+    const juce::int64 latency = processor.getLatencySamples();
+    const juce::int64 totalSamples = reader.lengthInSamples + latency;
+
+    for (juce::int64 position = 0; position < totalSamples; position += blockSize)
+    {
+        const int numSamples = (int) juce::jmin((juce::int64) blockSize, totalSamples - position);
+
+        if (numSamples != buffer.getNumSamples())
+            buffer.setSize(numChannels, numSamples, false, false, true);
+
+        if (! reader.read(&buffer, 0, numSamples, position, true, true))
+        {
+            result.errorMessage = "Failed to read input at sample " + juce::String(position);
+            break;
+        }
+
+        processor.processBlock(buffer);
+
+        const int numToSkip = (int) juce::jlimit((juce::int64) 0, (juce::int64) numSamples, latency - position);
+
+        if (numToSkip < numSamples && ! writeBlock(buffer, numToSkip, numSamples - numToSkip))
+        {
+            result.errorMessage = "Failed to write output at sample " + juce::String(position + numToSkip - latency);
+            break;
+        }
+
+        if (progressCallback != nullptr
+             && ! progressCallback((double) (position + numSamples) / (double) totalSamples))
+        {
+            result.errorMessage = "Cancelled";
+            break;
+        }
+    }
+
+    result.processingSeconds = juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - startTicks);
+    return result;
+}
+
+OfflineRenderer::Result OfflineRenderer::renderChunked(const ReaderFactory& createReader,
+                                                       const BlockWriter& writeBlock,
+                                                       const Settings& settings,
+                                                       const ProgressCallback& progressCallback)
+{
+    // Chunks are joined by handing the processor state over
+    jassert(settings.algorithm == AudioProcessorManager::Algorithm::amplitudeThreshold);
+
+    Result result;
+    const auto startTicks = juce::Time::getHighResolutionTicks();
+
+    // One reader and processor per thread; readers can't be shared between threads
+    std::vector<std::unique_ptr<ChunkRenderer>> renderers;
+
+    for (int i = 0; i < juce::jmax(1, settings.numThreads); ++i)
+    {
+        auto renderer = std::make_unique<ChunkRenderer>();
+        renderer->reader = createReader();
+
+        if (renderer->reader == nullptr)
+        {
+            result.errorMessage = "Could not open the input";
+            return result;
+        }
+
+        renderers.push_back(std::move(renderer));
+    }
+
+    const auto& firstReader = *renderers.front()->reader;
+    const auto length = firstReader.lengthInSamples;
+    const double sampleRate = firstReader.sampleRate;
+    const int numChannels = (int) firstReader.numChannels;
+
+    result.sampleRate = sampleRate;
+    result.numSamples = length;
+
+    if (numChannels <= 0 || sampleRate <= 0.0)
+    {
+        result.errorMessage = "Unsupported input format";
+        return result;
+    }
+
+    using Detection = DeEssEngine::Detection;
+    const bool isControlRate = settings.detection.mode != Detection::Mode::perSample;
+    const int controlInterval = isControlRate ? juce::jlimit(Detection::minControlInterval, Detection::maxControlInterval,
+                                                             settings.detection.controlInterval)
+                                              : 1;
+    const auto roundUpToInterval = [controlInterval] (int numSamples)
+    {
+        return (numSamples + controlInterval - 1) / controlInterval * controlInterval;
+    };
+
+    const int blockSize = juce::jmax(1, settings.blockSize);
+    const int hysteresisLength = juce::jmax(1, (int) settings.hysteresis);
+    const int warmUpLength = juce::roundToInt(juce::jmax(0.0, settings.preRollSeconds) * sampleRate);
+
+    // Control-rate detection decides on a grid of intervals counted from the
+    // start of the file, and its state includes the position on that grid,
+    // so chunks and their pre-rolls have to start on it. Its gate then stays
+    // open for whole intervals and glides one more before it settles.
+    const int chunkLength = roundUpToInterval(juce::jmax(blockSize, juce::roundToInt(settings.chunkSeconds * sampleRate)));
+    const int preRollLength = isControlRate ? roundUpToInterval(warmUpLength) + roundUpToInterval(hysteresisLength) + controlInterval
+                                            : warmUpLength + hysteresisLength;
+
+    // The true state at the start of the next chunk to be written; the file
+    // starts from the cold state, like render() does
+    prepareProcessor(processor, settings, sampleRate, numChannels);
+    auto handOverState = processor.getState();
+
+    const auto numThreads = (juce::int64) renderers.size();
+
+    // Renders numThreads chunks at a time, then checks and writes them in order,
+    // so only one round of chunks is ever held in memory
+    for (juce::int64 roundStart = 0; roundStart < length && result.wasSuccessful(); roundStart += numThreads * chunkLength)
+    {
+        const int numChunksInRound = (int) juce::jmin(numThreads, (length - roundStart + chunkLength - 1) / chunkLength);
+
+        for (int i = 0; i < numChunksInRound; ++i)
+        {
+            auto& chunk = *renderers[(size_t) i];
+            chunk.startSample = roundStart + (juce::int64) i * chunkLength;
+            chunk.numSamples = (int) juce::jmin((juce::int64) chunkLength, length - chunk.startSample);
+            chunk.preRollSamples = (int) juce::jmin((juce::int64) preRollLength, chunk.startSample);
+        }
+
+        std::vector<std::thread> threads;
+
+        for (int i = 1; i < numChunksInRound; ++i)
+            threads.emplace_back([&settings, &chunk = *renderers[(size_t) i]] { renderChunk(chunk, settings); });
+
+        renderChunk(*renderers.front(), settings);
+
+        for (auto& thread : threads)
+            thread.join();
+
+        for (int i = 0; i < numChunksInRound; ++i)
+        {
+            auto& chunk = *renderers[(size_t) i];
+            ++result.numChunks;
+
+            if (chunk.readSucceeded && chunk.startState != handOverState)
+            {
+                // The warm-up didn't land on the true state, e.g. because the
+                // previous chunk ended on a filter tail. Redo the chunk from the
+                // true state a block at a time until it meets the speculative
+                // run again; from there on that run's output is already exact.
+                ++result.numChunksRerendered;
+                processor.setState(handOverState);
+
+                for (size_t block = 0; block < chunk.blockEndStates.size(); ++block)
+                {
+                    const int offset = (int) block * blockSize;
+                    const int numSamples = juce::jmin(blockSize, chunk.numSamples - offset);
+                    const int bufferStart = chunk.preRollSamples + offset;
+
+                    chunk.readSucceeded = chunk.reader->read(&chunk.buffer, bufferStart, numSamples,
+                                                             chunk.startSample + offset, true, true);
+
+                    if (! chunk.readSucceeded)
+                        break;
+
+                    processRange(processor, chunk.buffer, bufferStart, numSamples);
+                    result.numSamplesRerendered += numSamples;
+
+                    auto state = processor.getState();
+
+                    if (state == chunk.blockEndStates[block])
+                        break;
+
+                    chunk.blockEndStates[block] = std::move(state);
+                }
+            }
+
+            if (! chunk.readSucceeded)
+            {
+                result.errorMessage = "Failed to read input at sample " + juce::String(chunk.startSample);
+                break;
+            }
+
+            if (! writeBlock(chunk.buffer, chunk.preRollSamples, chunk.numSamples))
+            {
+                result.errorMessage = "Failed to write output at sample " + juce::String(chunk.startSample);
+                break;
+            }
+
+            handOverState = std::move(chunk.blockEndStates.back());
+        }
+
+        if (result.wasSuccessful() && progressCallback != nullptr
+             && ! progressCallback((double) juce::jmin(length, roundStart + numThreads * chunkLength) / (double) length))
+        {
+            result.errorMessage = "Cancelled";
+        }
+    }
+
+    result.processingSeconds = juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - startTicks);
+    return result;
+}
+
+OfflineRenderer::Result OfflineRenderer::renderFile(juce::AudioFormatManager& formatManager,
+                                                    const juce::File& inputFile,
+                                                    const juce::File& outputFile,
+                                                    const Settings& settings,
+                                                    const ProgressCallback& progressCallback)
+{
+    Result result;
+
+    // Mapped WAV and AIFF input is shared by every chunk's reader
+    const MappedAudioFile input(formatManager, inputFile);
+    auto reader = input.createReader();
+
+    if (reader == nullptr)
+    {
+        result.errorMessage = "Could not open " + inputFile.getFullPathName();
+        return result;
+    }
+
+    outputFile.deleteFile();
+    std::unique_ptr<juce::OutputStream> outputStream(outputFile.createOutputStream());
+
+    if (outputStream == nullptr)
+    {
+        result.errorMessage = "Could not create " + outputFile.getFullPathName();
+        return result;
+    }
+
+    // Float input (e.g. 32-bit WAV) keeps its bit depth; anything else the WAV writer can't take gets 24 bits
+    juce::WavAudioFormat wavFormat;
+    const auto possibleDepths = wavFormat.getPossibleBitDepths();
+    const int bitsPerSample = possibleDepths.contains((int) reader->bitsPerSample) ? (int) reader->bitsPerSample : 24;
+
+    std::unique_ptr<juce::AudioFormatWriter> writer(wavFormat.createWriterFor(outputStream.get(),
+                                                                              reader->sampleRate,
+                                                                              reader->numChannels,
+                                                                              bitsPerSample,
+                                                                              reader->metadataValues,
+                                                                              0));
+
+    if (writer == nullptr)
+    {
+        result.errorMessage = "Could not create a WAV writer for " + outputFile.getFullPathName();
+        return result;
+    }
+
+    outputStream.release(); // Now owned by the writer
+
+    std::unique_ptr<DoubleBufferedWriter> backgroundWriter;
+    auto writeBlock = writeTo(*writer);
+
+    if (settings.writeOnBackgroundThread)
+    {
+        // Half a second per buffer keeps the disk busy without holding much in memory
+        const int bufferSamples = juce::jmax(settings.blockSize, juce::roundToInt(reader->sampleRate * 0.5));
+        backgroundWriter = std::make_unique<DoubleBufferedWriter>(std::move(writer), (int) reader->numChannels, bufferSamples);
+
+        writeBlock = [&backgroundWriter] (const juce::AudioBuffer<float>& buffer, int startSample, int numSamples)
+        {
+            return backgroundWriter->write(buffer, startSample, numSamples);
+        };
+    }
+
+    if (settings.numThreads > 1 && settings.algorithm == AudioProcessorManager::Algorithm::amplitudeThreshold)
+        result = renderChunked([&input] { return input.createReader(); }, writeBlock, settings, progressCallback);
+    else
+        result = render(*reader, writeBlock, settings, progressCallback);
+
+    if (backgroundWriter != nullptr && ! backgroundWriter->flush() && result.wasSuccessful())
+        result.errorMessage = "Failed to write " + outputFile.getFullPathName();
+
+    return result;
+}
@@ -0,0 +1,127 @@
+/*
+  ==============================================================================
+
+    OfflineRenderer.h
+    Created: 17 Oct 2026 3:20:11pm
+    Author:  Leif Rehtanz
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <functional>
+#include "AudioProcessorManager.h"
+
+// Runs AudioProcessorManager over a whole file as fast as the CPU allows,
+// reading and writing in large blocks. Shared by the command-line renderer
+// and anything else that needs de-essed audio without an audio device.
+// One instance owns one processor and its buffers, so give each worker
+// thread its own renderer; they can be reused for any number of files.
+class OfflineRenderer
+{
+public:
+    struct Settings
+    {
+        float threshold { -20.0f };
+        float mixLevel { 0.0f };
+        float frequency { 6500.0f };
+        float hysteresis { 50.0f };
+        AudioProcessorManager::Algorithm algorithm = AudioProcessorManager::Algorithm::amplitudeThreshold;
+        DeEssEngine::Detection detection;
+        int blockSize = 8192;
+
+        // renderFile() only: encode and write on a thread of its own, double
+        // buffered, so rendering doesn't wait for the disk
+        bool writeOnBackgroundThread = false;
+
+        // Used by renderChunked(), and by renderFile() when numThreads > 1.
+        // Chunking needs a processor state to hand over, which only the
+        // amplitude threshold algorithm has; renderFile() renders other
+        // algorithms in one pass.
+        int numThreads = 1;
+        double chunkSeconds = 30.0;
+        double preRollSeconds = 0.1;
+    };
+
+    struct Result
+    {
+        bool wasSuccessful() const noexcept { return errorMessage.isEmpty(); }
+
+        double getAudioSeconds() const noexcept { return sampleRate > 0.0 ? (double) numSamples / sampleRate : 0.0; }
+
+        // Audio duration divided by wall-clock time
+        double getSpeedFactor() const noexcept
+        {
+            return processingSeconds > 0.0 ? getAudioSeconds() / processingSeconds : 0.0;
+        }
+
+        juce::String errorMessage;
+        juce::int64 numSamples = 0;
+        double sampleRate = 0.0;
+        double processingSeconds = 0.0;
+
+        // Chunked renders only: chunks whose warm-up didn't reach the exact
+        // state of the previous chunk had their start rendered again
+        int numChunks = 0;
+        int numChunksRerendered = 0;
+        juce::int64 numSamplesRerendered = 0;
+    };
+
+    // Called after every block with the fraction rendered so far; return false to cancel
+    using ProgressCallback = std::function<bool(double progress)>;
+
+    // Each call must return a fresh reader for the same input
+    using ReaderFactory = std::function<std::unique_ptr<juce::AudioFormatReader>()>;
+
+    // Receives the rendered audio in order; returns false if it couldn't be written
+    using BlockWriter = std::function<bool(const juce::AudioBuffer<float>& buffer, int startSample, int numSamples)>;
+
+    OfflineRenderer() = default;
+
+    Result render(juce::AudioFormatReader& reader,
+                  juce::AudioFormatWriter& writer,
+                  const Settings& settings,
+                  const ProgressCallback& progressCallback = {});
+
+    Result render(juce::AudioFormatReader& reader,
+                  const BlockWriter& writeBlock,
+                  const Settings& settings,
+                  const ProgressCallback& progressCallback = {});
+
+    // Same output as render(), sample for sample, but the input is split into
+    // chunks of settings.chunkSeconds and settings.numThreads of them are
+    // rendered at once, each by its own processor and reader. A chunk starts
+    // with a cold processor preRollSeconds (plus the hysteresis time) early,
+    // so its filter state has settled by the time its own audio begins; with
+    // control-rate detection, chunks and pre-rolls start on its grid. That
+    // settled state is compared bit for bit with the state the previous chunk
+    // ended in. Where the warm-up didn't converge, the chunk is rendered again
+    // on the calling thread from the previous chunk's true state, block by
+    // block, until its state matches the one the speculative run recorded.
+    Result renderChunked(const ReaderFactory& createReader,
+                         juce::AudioFormatWriter& writer,
+                         const Settings& settings,
+                         const ProgressCallback& progressCallback = {});
+
+    Result renderChunked(const ReaderFactory& createReader,
+                         const BlockWriter& writeBlock,
+                         const Settings& settings,
+                         const ProgressCallback& progressCallback = {});
+
+    // Opens inputFile with formatManager and writes a WAV with the same sample
+    // rate, channel count and bit depth to outputFile, replacing it. Renders
+    // chunked when settings.numThreads is more than one.
+    Result renderFile(juce::AudioFormatManager& formatManager,
+                      const juce::File& inputFile,
+                      const juce::File& outputFile,
+                      const Settings& settings,
+                      const ProgressCallback& progressCallback = {});
+
+private:
+    AudioProcessorManager processor;
+    juce::AudioBuffer<float> buffer;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(OfflineRenderer)
+};
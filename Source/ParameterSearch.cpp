@@ -0,0 +1,285 @@
+/*
+  ==============================================================================
+
+    ParameterSearch.cpp
+    Created: 18 Oct 2026 2:15:48am
+    Author:  Leif Rehtanz
+
+  ==============================================================================
+*/
+
+#include "ParameterSearch.h"
+#include "MultichannelLinkwitzRiley.h"
+#include <algorithm>
+#include <atomic>
+#include <limits>
+#include <thread>
+
+namespace
+{
+    constexpr int filterBlockSize = 1 << 16;
+
+    // A frame counts as sibilant when at least this share of its energy is in
+    // the reference band, and it's louder than silenceLevel (-60 dBFS RMS)
+    constexpr double sibilantEnergyShare = 0.5;
+    constexpr double silenceLevel = 1.0e-6;
+
+    double energyRatioDb(double before, double after)
+    {
+        if (before <= 0.0)
+            return 0.0;
+
+        return 10.0 * std::log10(before / juce::jmax(after, std::numeric_limits<double>::min()));
+    }
+}
+
+ParameterSearch::ParameterSearch()
+    : kernels(DeEssKernels::getBestKernels())
+{
+}
+
+ParameterSearch::Result ParameterSearch::search(juce::AudioFormatReader& reader,
+                                                const Settings& settings,
+                                                const ProgressCallback& progressCallback)
+{
+    Result result;
+    const auto startTicks = juce::Time::getHighResolutionTicks();
+
+    sampleRate = reader.sampleRate;
+    numChannels = (int) reader.numChannels;
+
+    if (numChannels <= 0 || sampleRate <= 0.0 || reader.lengthInSamples <= 0
+         || reader.lengthInSamples > std::numeric_limits<int>::max())
+    {
+        result.errorMessage = "Unsupported input format";
+        return result;
+    }
+
+    if (settings.frequencies.isEmpty() || settings.thresholds.isEmpty() || settings.hysteresisValues.isEmpty())
+    {
+        result.errorMessage = "Nothing to search";
+        return result;
+    }
+
+    numSamples = (int) reader.lengthInSamples;
+    input.setSize(numChannels, numSamples);
+
+    if (! reader.read(&input, 0, numSamples, 0, true, true))
+    {
+        result.errorMessage = "Failed to read the input";
+        return result;
+    }
+
+    classifyFrames(settings.referenceFrequency);
+    result.sibilantFraction = (double) std::count(sibilantFrames.begin(), sibilantFrames.end(), true)
+                                / (double) sibilantFrames.size();
+
+    const auto mixGain = juce::Decibels::decibelsToGain(settings.mixLevel);
+    const int numPerFrequency = settings.thresholds.size() * settings.hysteresisValues.size();
+    const int numCandidates = settings.frequencies.size() * numPerFrequency;
+    const int numThreads = juce::jlimit(1, numPerFrequency, settings.numThreads);
+
+    result.candidates.resize((size_t) numCandidates);
+    std::atomic<bool> cancelled { false };
+    Bands bands;
+
+    for (int f = 0; f < settings.frequencies.size() && ! cancelled.load(); ++f)
+    {
+        // Clamped the way the engine clamps it
+        const auto frequency = juce::jlimit(20.0f, (float) (sampleRate * 0.49), settings.frequencies[f]);
+        filterBands(frequency, bands);
+
+        std::atomic<int> nextCandidate { 0 };
+
+        // Each thread takes the next candidate until none are left, so uneven
+        // candidates still keep every thread busy
+        auto evaluateCandidates = [&] (bool reportsProgress)
+        {
+            for (int i = nextCandidate++; i < numPerFrequency && ! cancelled.load(); i = nextCandidate++)
+            {
+                const auto thresholdDb = settings.thresholds[i / settings.hysteresisValues.size()];
+                const auto hysteresis = juce::jmax(1, settings.hysteresisValues[i % settings.hysteresisValues.size()]);
+
+                auto& candidate = result.candidates[(size_t) (f * numPerFrequency + i)];
+                candidate = evaluate(bands, thresholdDb, frequency, hysteresis, mixGain);
+                candidate.score = candidate.sibilantReductionDb - settings.collateralWeight * candidate.collateralChangeDb;
+
+                // Only the calling thread reports, so the callback never runs concurrently
+                if (reportsProgress && progressCallback != nullptr
+                     && ! progressCallback((double) (f * numPerFrequency + juce::jmin(nextCandidate.load(), numPerFrequency))
+                                             / (double) numCandidates))
+                    cancelled = true;
+            }
+        };
+
+        std::vector<std::thread> threads;
+
+        for (int i = 1; i < numThreads; ++i)
+            threads.emplace_back([&evaluateCandidates] { evaluateCandidates(false); });
+
+        evaluateCandidates(true);
+
+        for (auto& thread : threads)
+            thread.join();
+    }
+
+    if (cancelled.load())
+    {
+        result.errorMessage = "Cancelled";
+        result.candidates.clear();
+    }
+
+    // Best first; between equal scores the gentler setting wins
+    std::stable_sort(result.candidates.begin(), result.candidates.end(), [] (const Candidate& a, const Candidate& b)
+    {
+        if (a.score != b.score)
+            return a.score > b.score;
+
+        return a.collateralChangeDb < b.collateralChangeDb;
+    });
+
+    // The file isn't needed between searches
+    input.setSize(0, 0);
+
+    result.processingSeconds = juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - startTicks);
+    return result;
+}
+
+void ParameterSearch::filterBands(float frequency, Bands& bands) const
+{
+    MultichannelLinkwitzRiley crossover;
+    crossover.prepare({ sampleRate, (juce::uint32) filterBlockSize, (juce::uint32) numChannels });
+    crossover.setCutoffFrequency(frequency);
+    crossover.reset();
+
+    bands.fullBand.setSize(numChannels, numSamples, false, false, true);
+    bands.highBand.setSize(numChannels, numSamples, false, false, true);
+
+    juce::dsp::AudioBlock<float> fullBlock(bands.fullBand);
+    juce::dsp::AudioBlock<float> highBlock(bands.highBand);
+
+    for (int start = 0; start < numSamples; start += filterBlockSize)
+    {
+        const int count = juce::jmin(filterBlockSize, numSamples - start);
+
+        juce::dsp::AudioBlock<const float> inputBlock(input.getArrayOfReadPointers(), (size_t) numChannels,
+                                                      (size_t) start, (size_t) count);
+        auto fullOut = fullBlock.getSubBlock((size_t) start, (size_t) count);
+        auto highOut = highBlock.getSubBlock((size_t) start, (size_t) count);
+        crossover.processCrossover(inputBlock, fullOut, highOut);
+    }
+
+    const int numFrames = (numSamples + frameLength - 1) / frameLength;
+    bands.frameEnergies.assign((size_t) numFrames, 0.0);
+
+    for (int channel = 0; channel < numChannels; ++channel)
+    {
+        const auto* full = bands.fullBand.getReadPointer(channel);
+
+        for (int i = 0; i < numSamples; ++i)
+            bands.frameEnergies[(size_t) (i / frameLength)] += (double) full[i] * full[i];
+    }
+}
+
+void ParameterSearch::classifyFrames(float referenceFrequency)
+{
+    Bands reference;
+    filterBands(juce::jlimit(20.0f, (float) (sampleRate * 0.49), referenceFrequency), reference);
+
+    std::vector<double> highEnergies(reference.frameEnergies.size(), 0.0);
+
+    for (int channel = 0; channel < numChannels; ++channel)
+    {
+        const auto* high = reference.highBand.getReadPointer(channel);
+
+        for (int i = 0; i < numSamples; ++i)
+            highEnergies[(size_t) (i / frameLength)] += (double) high[i] * high[i];
+    }
+
+    sibilantFrames.resize(highEnergies.size());
+
+    for (size_t frame = 0; frame < highEnergies.size(); ++frame)
+    {
+        const auto energy = reference.frameEnergies[frame];
+        const auto frameSamples = (double) numChannels * frameLength;
+
+        sibilantFrames[frame] = energy > silenceLevel * frameSamples
+                                 && highEnergies[frame] >= sibilantEnergyShare * energy;
+    }
+}
+
+ParameterSearch::Candidate ParameterSearch::evaluate(const Bands& bands, float thresholdDb, float frequency,
+                                                     int hysteresis, float mixGain) const
+{
+    const auto threshold = juce::Decibels::decibelsToGain(thresholdDb);
+
+    // The engine's kernels work in place, so each block is copied first
+    juce::AudioBuffer<float> original(1, evaluationBlockSize), sibilant(1, evaluationBlockSize);
+    std::vector<int> counters((size_t) numChannels, 0);
+    std::vector<double> blockFrameEnergies((size_t) (evaluationBlockSize / frameLength));
+
+    double sibilantBefore = 0.0, sibilantAfter = 0.0, otherBefore = 0.0, otherAfter = 0.0;
+    juce::int64 numGated = 0;
+
+    for (int start = 0; start < numSamples; start += evaluationBlockSize)
+    {
+        const int count = juce::jmin(evaluationBlockSize, numSamples - start);
+        std::fill(blockFrameEnergies.begin(), blockFrameEnergies.end(), 0.0);
+
+        for (int channel = 0; channel < numChannels; ++channel)
+        {
+            auto* originalData = original.getWritePointer(0);
+            auto* sibilantData = sibilant.getWritePointer(0);
+
+            juce::FloatVectorOperations::copy(originalData, bands.fullBand.getReadPointer(channel, start), count);
+            juce::FloatVectorOperations::copy(sibilantData, bands.highBand.getReadPointer(channel, start), count);
+
+            kernels.hysteresisGate(originalData, sibilantData, count, threshold, nullptr,
+                                   hysteresis, counters[(size_t) channel]);
+
+            // Gated samples keep their high band, the rest were cleared
+            numGated += std::count_if(sibilantData, sibilantData + count, [] (float sample) { return sample != 0.0f; });
+
+            kernels.mixSibilants(originalData, originalData, sibilantData, mixGain, nullptr, count);
+
+            for (int frameStart = 0; frameStart < count; frameStart += frameLength)
+            {
+                const int frameEnd = juce::jmin(count, frameStart + frameLength);
+                double energy = 0.0;
+
+                for (int i = frameStart; i < frameEnd; ++i)
+                    energy += (double) originalData[i] * originalData[i];
+
+                blockFrameEnergies[(size_t) (frameStart / frameLength)] += energy;
+            }
+        }
+
+        const int firstFrame = start / frameLength;
+
+        for (int frame = 0; frame * frameLength < count; ++frame)
+        {
+            const auto before = bands.frameEnergies[(size_t) (firstFrame + frame)];
+            const auto after = blockFrameEnergies[(size_t) frame];
+
+            if (sibilantFrames[(size_t) (firstFrame + frame)])
+            {
+                sibilantBefore += before;
+                sibilantAfter += after;
+            }
+            else
+            {
+                otherBefore += before;
+                otherAfter += after;
+            }
+        }
+    }
+
+    Candidate candidate;
+    candidate.threshold = thresholdDb;
+    candidate.frequency = frequency;
+    candidate.hysteresis = (float) hysteresis;
+    candidate.sibilantReductionDb = energyRatioDb(sibilantBefore, sibilantAfter);
+    candidate.collateralChangeDb = energyRatioDb(otherBefore, otherAfter);
+    candidate.gatedFraction = (double) numGated / ((double) numSamples * numChannels);
+    return candidate;
+}
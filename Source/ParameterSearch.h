@@ -0,0 +1,110 @@
+/*
+  ==============================================================================
+
+    ParameterSearch.h
+    Created: 18 Oct 2026 2:15:48am
+    Author:  Leif Rehtanz
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <functional>
+#include <vector>
+#include "DeEssKernels.h"
+
+// Tries a grid of amplitude threshold settings on one file and ranks them, to
+// start listening from a good guess instead of from the defaults.
+//
+// The file is split into short frames, and a frame counts as sibilant when
+// most of its energy sits above referenceFrequency. A candidate scores the
+// energy it takes out of the sibilant frames, less collateralWeight times the
+// energy it takes out of everything else, both in dB, so settings that only
+// touch the esses rank first.
+//
+// Every candidate is rendered exactly as AmplitudeThresholdEngine would
+// render it, with the same gate and mix kernels, but the crossover runs once
+// per frequency: candidates sharing a frequency are evaluated from the same
+// filtered bands, spread over numThreads threads. The whole file and the
+// bands for one frequency are held in memory while searching.
+class ParameterSearch
+{
+public:
+    struct Settings
+    {
+        juce::Array<float> frequencies { 4000.0f, 5000.0f, 6000.0f, 7000.0f, 8000.0f, 9000.0f };
+        juce::Array<float> thresholds { -45.0f, -40.0f, -35.0f, -30.0f, -25.0f, -20.0f, -15.0f };
+        juce::Array<int> hysteresisValues { 25, 50, 100, 200, 400 };
+
+        // Not searched: deeper reduction always takes out more of both
+        float mixLevel { -12.0f };
+
+        float referenceFrequency { 4000.0f };
+        float collateralWeight { 4.0f };
+        int numThreads = juce::SystemStats::getNumCpus();
+    };
+
+    struct Candidate
+    {
+        // Same units as OfflineRenderer::Settings
+        float threshold = 0.0f;
+        float frequency = 0.0f;
+        float hysteresis = 0.0f;
+
+        double score = 0.0;
+        double sibilantReductionDb = 0.0;   // Energy taken out of the sibilant frames
+        double collateralChangeDb = 0.0;    // Energy taken out of all other frames
+        double gatedFraction = 0.0;         // Share of samples the gate attenuated
+    };
+
+    struct Result
+    {
+        bool wasSuccessful() const noexcept { return errorMessage.isEmpty(); }
+
+        juce::String errorMessage;
+
+        // Best first
+        std::vector<Candidate> candidates;
+
+        double sibilantFraction = 0.0;      // Share of frames counted as sibilant
+        double processingSeconds = 0.0;
+    };
+
+    // Called after each candidate with the fraction searched so far; return false to cancel
+    using ProgressCallback = std::function<bool(double progress)>;
+
+    ParameterSearch();
+
+    Result search(juce::AudioFormatReader& reader,
+                  const Settings& settings,
+                  const ProgressCallback& progressCallback = {});
+
+private:
+    static constexpr int frameLength = 1024;
+    static constexpr int evaluationBlockSize = 16 * frameLength;
+
+    // Crossover outputs for the whole file at one frequency, and the input
+    // energy of each frame (taken from the phase-aligned full band)
+    struct Bands
+    {
+        juce::AudioBuffer<float> fullBand, highBand;
+        std::vector<double> frameEnergies;
+    };
+
+    void filterBands(float frequency, Bands& bands) const;
+    void classifyFrames(float referenceFrequency);
+    Candidate evaluate(const Bands& bands, float thresholdDb, float frequency, int hysteresis, float mixGain) const;
+
+    // Picked once, before any search thread starts
+    const DeEssKernels::KernelSet& kernels;
+
+    juce::AudioBuffer<float> input;
+    double sampleRate = 0.0;
+    int numChannels = 0;
+    int numSamples = 0;
+    std::vector<bool> sibilantFrames;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ParameterSearch)
+};
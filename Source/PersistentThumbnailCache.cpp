@@ -0,0 +1,173 @@
+/*
+  ==============================================================================
+
+    PersistentThumbnailCache.cpp
+    Created: 17 Oct 2026 10:26:48pm
+    Author:  Leif Rehtanz
+
+  ==============================================================================
+*/
+
+#include "PersistentThumbnailCache.h"
+
+namespace
+{
+    // FNV-1a, 64-bit
+    juce::uint64 hashBytes(juce::uint64 hash, const void* data, size_t numBytes)
+    {
+        const auto* bytes = static_cast<const juce::uint8*>(data);
+
+        for (size_t i = 0; i < numBytes; ++i)
+            hash = (hash ^ bytes[i]) * 0x100000001b3ull;
+
+        return hash;
+    }
+
+    juce::int64 hashFileContent(const juce::File& file)
+    {
+        constexpr int numSamples = 16;
+        constexpr int sampleSize = 64 * 1024;
+
+        const auto size = file.getSize();
+        const auto modificationTime = file.getLastModificationTime().toMilliseconds();
+
+        auto hash = hashBytes(0xcbf29ce484222325ull, &size, sizeof(size));
+        hash = hashBytes(hash, &modificationTime, sizeof(modificationTime));
+
+        // Evenly spaced windows from the header to the very end: enough to
+        // tell takes apart without reading gigabytes
+        juce::FileInputStream stream(file);
+
+        if (stream.openedOk())
+        {
+            juce::HeapBlock<char> buffer(sampleSize);
+
+            for (int i = 0; i < numSamples; ++i)
+            {
+                const auto position = juce::jmax((juce::int64) 0, (size - sampleSize) * i / (numSamples - 1));
+
+                if (! stream.setPosition(position))
+                    break;
+
+                const int numRead = stream.read(buffer.get(), sampleSize);
+                hash = hashBytes(hash, buffer.get(), (size_t) juce::jmax(0, numRead));
+            }
+        }
+
+        return (juce::int64) hash;
+    }
+
+    class ContentHashedInputSource : public juce::FileInputSource
+    {
+    public:
+        explicit ContentHashedInputSource(const juce::File& file)
+            : juce::FileInputSource(file),
+              contentHash(hashFileContent(file))
+        {
+        }
+
+        juce::int64 hashCode() const override  { return contentHash; }
+
+    private:
+        const juce::int64 contentHash;
+    };
+}
+
+PersistentThumbnailCache::PersistentThumbnailCache(int maxThumbsInMemory,
+                                                   const juce::File& cacheDirectory,
+                                                   juce::int64 maxBytesOnDisk)
+    : juce::AudioThumbnailCache(maxThumbsInMemory),
+      directory(cacheDirectory),
+      maxBytes(maxBytesOnDisk)
+{
+    directory.createDirectory();
+}
+
+juce::InputSource* PersistentThumbnailCache::createInputSource(const juce::File& file)
+{
+    return new ContentHashedInputSource(file);
+}
+
+juce::int64 PersistentThumbnailCache::getContentHash(const juce::File& file)
+{
+    return hashFileContent(file);
+}
+
+juce::File PersistentThumbnailCache::getDefaultDirectory()
+{
+    return juce::File::getSpecialLocation(juce::File::userApplicationDataDirectory)
+               .getChildFile("DeEssDoctor")
+               .getChildFile("Thumbnails");
+}
+
+juce::File PersistentThumbnailCache::getFileFor(juce::int64 hashCode) const
+{
+    return directory.getChildFile(juce::String::toHexString(hashCode) + ".thumb");
+}
+
+bool PersistentThumbnailCache::loadNewThumb(juce::AudioThumbnailBase& thumb, juce::int64 hashCode)
+{
+    const juce::ScopedLock sl(diskLock);
+    const auto file = getFileFor(hashCode);
+
+    juce::FileInputStream stream(file);
+
+    if (! stream.openedOk() || ! thumb.loadFrom(stream))
+        return false;
+
+    // The modification time doubles as the last use for eviction
+    file.setLastModificationTime(juce::Time::getCurrentTime());
+    return true;
+}
+
+void PersistentThumbnailCache::saveNewlyFinishedThumbnail(const juce::AudioThumbnailBase& thumb, juce::int64 hashCode)
+{
+    const juce::ScopedLock sl(diskLock);
+    const auto file = getFileFor(hashCode);
+
+    // Write next to the final name first so a crash never leaves half a thumbnail
+    juce::TemporaryFile temporary(file);
+
+    {
+        juce::FileOutputStream stream(temporary.getFile());
+
+        if (! stream.openedOk())
+            return;
+
+        thumb.saveTo(stream);
+        stream.flush();
+
+        if (stream.getStatus().failed())
+            return;
+    }
+
+    if (temporary.overwriteTargetFileWithTemporary())
+        trimToSize();
+}
+
+void PersistentThumbnailCache::trimToSize()
+{
+    auto files = directory.findChildFiles(juce::File::findFiles, false, "*.thumb");
+
+    juce::int64 totalBytes = 0;
+
+    for (auto& file : files)
+        totalBytes += file.getSize();
+
+    if (totalBytes <= maxBytes)
+        return;
+
+    std::sort(files.begin(), files.end(), [] (const juce::File& a, const juce::File& b)
+    {
+        return a.getLastModificationTime() < b.getLastModificationTime();
+    });
+
+    for (auto& file : files)
+    {
+        if (totalBytes <= maxBytes)
+            break;
+
+        totalBytes -= file.getSize();
+        file.deleteFile();
+    }
+}
@@ -0,0 +1,51 @@
+/*
+  ==============================================================================
+
+    PersistentThumbnailCache.h
+    Created: 17 Oct 2026 10:26:48pm
+    Author:  Leif Rehtanz
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+// AudioThumbnailCache that also keeps every finished thumbnail on disk, so a
+// file seen in an earlier session draws its waveform without a rescan.
+// Thumbnails are stored under the hash of the input source, so open files
+// through createInputSource(), which hashes the content rather than the path:
+// a moved or renamed file still hits, an edited one misses. The directory is
+// trimmed back to maxBytesOnDisk after every save, least recently used first.
+class PersistentThumbnailCache : public juce::AudioThumbnailCache
+{
+public:
+    explicit PersistentThumbnailCache(int maxThumbsInMemory,
+                                      const juce::File& cacheDirectory = getDefaultDirectory(),
+                                      juce::int64 maxBytesOnDisk = 256 * 1024 * 1024);
+
+    // FileInputSource whose hash covers size, modification time and a sample
+    // of the file's bytes. Reads about 1 MB, whatever the file size.
+    static juce::InputSource* createInputSource(const juce::File& file);
+
+    // The same hash, for thumbnails fed through AudioThumbnail::setReader()
+    static juce::int64 getContentHash(const juce::File& file);
+
+    static juce::File getDefaultDirectory();
+
+private:
+    bool loadNewThumb(juce::AudioThumbnailBase& thumb, juce::int64 hashCode) override;
+    void saveNewlyFinishedThumbnail(const juce::AudioThumbnailBase& thumb, juce::int64 hashCode) override;
+
+    juce::File getFileFor(juce::int64 hashCode) const;
+    void trimToSize();
+
+    const juce::File directory;
+    const juce::int64 maxBytes;
+
+    // Saves arrive on the cache's loader thread, loads on the message thread
+    juce::CriticalSection diskLock;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(PersistentThumbnailCache)
+};
@@ -1,50 +1,111 @@
-/*
-  ==============================================================================
-
-    PositionOverlay.cpp
-    Created: 29 Nov 2024 8:11:02pm
-    Author:  Leif Rehtanz
-
-  ==============================================================================
-*/
-
-#include "PositionOverlay.h"
-
-
-PositionOverlay::PositionOverlay(juce::AudioTransportSource& transportSourceToUse)
-    : transportSource(transportSourceToUse)
-{
-    startTimer(40);
-}
-
-void PositionOverlay::paint(juce::Graphics& g)
-{
-    auto duration = (float)transportSource.getLengthInSeconds();
-
-    if (duration > 0.0)
-    {
-        auto audioPosition = (float)transportSource.getCurrentPosition();
-        auto drawPosition = (audioPosition / duration) * (float)getWidth();
-
-        g.setColour(juce::Colours::green);
-        g.drawLine(drawPosition, 0.0f, drawPosition, (float)getHeight(), 2.0f);
-    }
-}
-
-void PositionOverlay::mouseDown(const juce::MouseEvent& event)
-{
-    auto duration = transportSource.getLengthInSeconds();
-
-    if (duration > 0.0)
-    {
-        auto clickPosition = event.position.x;
-        auto audioPosition = (clickPosition / (float)getWidth()) * duration;
-
-        transportSource.setPosition(audioPosition);
-    }
-}
-
-void PositionOverlay::timerCallback()
-{
-    repaint();
-}
+/*
+  ==============================================================================
+
+    PositionOverlay.cpp
+    Created: 29 Nov 2024 8:11:02pm
+    Author:  Leif Rehtanz
+
+  ==============================================================================
+*/
+
+#include "PositionOverlay.h"
+
+
+PositionOverlay::PositionOverlay(juce::AudioTransportSource& transportSourceToUse)
+    : transportSource(transportSourceToUse),
+      vBlankAttachment(this, [this] { updateCursor(); })
+{
+}
+
+void PositionOverlay::paint(juce::Graphics& g)
+{
+    if (cursorX >= 0.0f)
+    {
+        g.setColour(juce::Colours::green);
+        g.drawLine(cursorX, 0.0f, cursorX, (float)getHeight(), cursorThickness);
+    }
+}
+
+void PositionOverlay::mouseDown(const juce::MouseEvent& event)
+{
+    auto timeRange = getTimeRange();
+
+    if (timeRange.getLength() > 0.0)
+    {
+        auto clickPosition = event.position.x;
+        auto audioPosition = timeRange.getStart() + (clickPosition / (float)getWidth()) * timeRange.getLength();
+
+        transportSource.setPosition(audioPosition);
+    }
+}
+
+void PositionOverlay::mouseWheelMove(const juce::MouseEvent& event, const juce::MouseWheelDetails& wheel)
+{
+    if (mouseWheelMoved)
+        mouseWheelMoved(event, wheel);
+}
+
+void PositionOverlay::mouseMagnify(const juce::MouseEvent& event, float scaleFactor)
+{
+    if (mouseMagnified)
+        mouseMagnified(event, scaleFactor);
+}
+
+void PositionOverlay::setVisibleRange(juce::Range<double> newRange)
+{
+    visibleRange = newRange;
+
+    // Everything moves under the cursor, so it's a full repaint anyway
+    cursorX = getCursorX();
+    repaint();
+}
+
+juce::Range<double> PositionOverlay::getTimeRange() const
+{
+    if (visibleRange.isEmpty())
+        return { 0.0, transportSource.getLengthInSeconds() };
+
+    return visibleRange;
+}
+
+void PositionOverlay::resized()
+{
+    cursorX = getCursorX();
+    repaint();
+}
+
+float PositionOverlay::getCursorX() const
+{
+    auto timeRange = getTimeRange();
+    auto audioPosition = transportSource.getCurrentPosition();
+
+    if (timeRange.getLength() <= 0.0 || ! timeRange.contains(audioPosition))
+        return -1.0f;
+
+    return (float) ((audioPosition - timeRange.getStart()) / timeRange.getLength()) * (float)getWidth();
+}
+
+juce::Rectangle<int> PositionOverlay::getCursorStrip(float x) const
+{
+    // Wide enough for the antialiased edges of the line
+    const auto left = (int) std::floor(x - cursorThickness);
+    return { left, 0, (int) std::ceil(x + cursorThickness) - left + 1, getHeight() };
+}
+
+void PositionOverlay::updateCursor()
+{
+    const auto newCursorX = getCursorX();
+
+    // Sub-pixel moves still move the antialiased line, but not by enough to
+    // be worth a repaint
+    if (std::abs(newCursorX - cursorX) < 0.25f)
+        return;
+
+    if (cursorX >= 0.0f)
+        repaint(getCursorStrip(cursorX));
+
+    cursorX = newCursorX;
+
+    if (cursorX >= 0.0f)
+        repaint(getCursorStrip(cursorX));
+}
@@ -1,30 +1,52 @@
-/*
-  ==============================================================================
-
-    PositionOverlay.h
-    Created: 29 Nov 2024 8:11:02pm
-    Author:  Leif Rehtanz
-
-  ==============================================================================
-*/
-
-#pragma once
-
-#include <JuceHeader.h>
-
-class PositionOverlay : public juce::Component,
-                              private juce::Timer
-{
-public:
-    PositionOverlay(juce::AudioTransportSource& transportSourceToUse);
-
-    void paint(juce::Graphics& g) override;
-    void mouseDown(const juce::MouseEvent& event) override;
-
-private:
-    void timerCallback() override;
-
-    juce::AudioTransportSource& transportSource;
-
-    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(PositionOverlay)
-};
+/*
+  ==============================================================================
+
+    PositionOverlay.h
+    Created: 29 Nov 2024 8:11:02pm
+    Author:  Leif Rehtanz
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <functional>
+
+class PositionOverlay : public juce::Component
+{
+public:
+    PositionOverlay(juce::AudioTransportSource& transportSourceToUse);
+
+    void paint(juce::Graphics& g) override;
+    void mouseDown(const juce::MouseEvent& event) override;
+    void mouseWheelMove(const juce::MouseEvent& event, const juce::MouseWheelDetails& wheel) override;
+    void mouseMagnify(const juce::MouseEvent& event, float scaleFactor) override;
+    void resized() override;
+
+    // The part of the file the waveform underneath shows, in seconds; an
+    // empty range means the whole file
+    void setVisibleRange(juce::Range<double> newRange);
+
+    // The overlay sits on top of the waveform and catches its mouse
+    // events, so zoom and scroll gestures are handed on through these
+    std::function<void(const juce::MouseEvent&, const juce::MouseWheelDetails&)> mouseWheelMoved;
+    std::function<void(const juce::MouseEvent&, float)> mouseMagnified;
+
+private:
+    // Once per display refresh: moves the cursor, repainting only the strip
+    // it leaves and the strip it enters
+    void updateCursor();
+    float getCursorX() const;
+    juce::Rectangle<int> getCursorStrip(float x) const;
+    juce::Range<double> getTimeRange() const;
+
+    static constexpr float cursorThickness = 2.0f;
+
+    juce::AudioTransportSource& transportSource;
+    juce::Range<double> visibleRange;
+    float cursorX = -1.0f; // Negative while there is nothing to draw
+    juce::VBlankAttachment vBlankAttachment;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(PositionOverlay)
+};
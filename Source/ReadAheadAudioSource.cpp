@@ -0,0 +1,226 @@
+/*
+  ==============================================================================
+
+    ReadAheadAudioSource.cpp
+    Created: 17 Oct 2026 11:41:37pm
+    Author:  Leif Rehtanz
+
+  ==============================================================================
+*/
+
+#include "ReadAheadAudioSource.h"
+
+namespace
+{
+    // Largest read per time slice, so a seek never waits long for the read in flight
+    constexpr int maxChunkSize = 8192;
+}
+
+ReadAheadAudioSource::ReadAheadAudioSource(juce::PositionableAudioSource* sourceToUse,
+                                           bool deleteSourceWhenDeleted,
+                                           juce::TimeSliceThread& readThreadToUse,
+                                           int bufferSizeSamples,
+                                           int prefillSamples,
+                                           int numChannelsToBuffer)
+    : source(sourceToUse, deleteSourceWhenDeleted),
+      readThread(readThreadToUse),
+      bufferSize(juce::jmax(1024, bufferSizeSamples)),
+      prefillSize(juce::jlimit(0, bufferSize, prefillSamples)),
+      numChannels(juce::jmax(1, numChannelsToBuffer))
+{
+    jassert(source != nullptr);
+}
+
+ReadAheadAudioSource::~ReadAheadAudioSource()
+{
+    readThread.removeTimeSliceClient(this);
+}
+
+void ReadAheadAudioSource::prepareToPlay(int samplesPerBlockExpected, double sampleRate)
+{
+    {
+        const juce::ScopedLock rl(readLock);
+
+        source->prepareToPlay(samplesPerBlockExpected, sampleRate);
+        buffer.setSize(numChannels, bufferSize);
+        isPrepared = true;
+
+        const auto position = nextPlayPosition.load();
+        const juce::SpinLock::ScopedLockType sl(rangeLock);
+        validStart = validEnd = position;
+    }
+
+    prefill();
+    readThread.addTimeSliceClient(this);
+}
+
+void ReadAheadAudioSource::releaseResources()
+{
+    readThread.removeTimeSliceClient(this);
+
+    const juce::ScopedLock rl(readLock);
+    isPrepared = false;
+    buffer.setSize(numChannels, 0);
+    source->releaseResources();
+}
+
+void ReadAheadAudioSource::getNextAudioBlock(const juce::AudioSourceChannelInfo& info)
+{
+    const auto position = nextPlayPosition.load();
+    juce::int64 start = 0, end = 0;
+
+    {
+        // The read thread only holds this for a few instructions; if it does
+        // right now, this block counts as unbuffered rather than waiting
+        const juce::SpinLock::ScopedTryLockType sl(rangeLock);
+
+        if (sl.isLocked())
+        {
+            start = validStart;
+            end = validEnd;
+        }
+    }
+
+    const int numAvailable = position >= start && position < end
+                               ? (int) juce::jmin((juce::int64) info.numSamples, end - position)
+                               : 0;
+
+    const int channelsToCopy = juce::jmin(numChannels, info.buffer->getNumChannels());
+
+    // Up to two copies, where the range wraps around the ring
+    for (int done = 0; done < numAvailable;)
+    {
+        const int ringIndex = (int) ((position + done) % bufferSize);
+        const int numSamples = juce::jmin(numAvailable - done, bufferSize - ringIndex);
+
+        for (int channel = 0; channel < channelsToCopy; ++channel)
+            info.buffer->copyFrom(channel, info.startSample + done, buffer, channel, ringIndex, numSamples);
+
+        done += numSamples;
+    }
+
+    for (int channel = channelsToCopy; channel < info.buffer->getNumChannels(); ++channel)
+        info.buffer->clear(channel, info.startSample, numAvailable);
+
+    if (numAvailable < info.numSamples)
+    {
+        const int numMissing = info.numSamples - numAvailable;
+        info.buffer->clear(info.startSample + numAvailable, numMissing);
+
+        // Silence while a seek refills the buffer is expected, not a dropout
+        if (! isSeeking.load())
+        {
+            ++numUnderruns;
+            numUnderrunSamples += numMissing;
+        }
+    }
+
+    // Time moves on even through an underrun. A seek that landed meanwhile wins.
+    auto expected = position;
+    nextPlayPosition.compare_exchange_strong(expected, position + info.numSamples);
+}
+
+void ReadAheadAudioSource::setNextReadPosition(juce::int64 newPosition)
+{
+    // Waits out a read in flight, so the prefill below is the next read
+    const juce::ScopedLock rl(readLock);
+
+    isSeeking = true;
+    nextPlayPosition.store(newPosition);
+
+    {
+        // A seek that lands in the buffered range keeps it
+        const juce::SpinLock::ScopedLockType sl(rangeLock);
+
+        if (newPosition < validStart || newPosition > validEnd)
+            validStart = validEnd = newPosition;
+        else
+            validStart = newPosition;
+    }
+
+    prefill();
+    isSeeking = false;
+}
+
+juce::int64 ReadAheadAudioSource::getNextReadPosition() const
+{
+    const auto position = nextPlayPosition.load();
+    const auto totalLength = source->getTotalLength();
+
+    return isLooping() && totalLength > 0 ? position % totalLength : position;
+}
+
+void ReadAheadAudioSource::resetUnderrunCount() noexcept
+{
+    numUnderruns = 0;
+    numUnderrunSamples = 0;
+}
+
+int ReadAheadAudioSource::useTimeSlice()
+{
+    // Straight back while there is catching up to do, then poll
+    return readNextChunk() ? 1 : 10;
+}
+
+bool ReadAheadAudioSource::readNextChunk()
+{
+    const juce::ScopedLock rl(readLock);
+
+    if (! isPrepared)
+        return false;
+
+    const auto playPosition = nextPlayPosition.load();
+    juce::int64 readStart = 0, readEnd = 0;
+
+    {
+        // Played samples free their slots; a jump past the buffered range
+        // (an underrun, or a seek) starts it afresh at the play position
+        const juce::SpinLock::ScopedLockType sl(rangeLock);
+
+        if (playPosition < validStart || playPosition > validEnd)
+            validStart = validEnd = playPosition;
+        else
+            validStart = playPosition;
+
+        readStart = validEnd;
+        readEnd = juce::jmin(validStart + bufferSize, readStart + maxChunkSize);
+    }
+
+    if (readEnd <= readStart)
+        return false;
+
+    // Outside the valid range, so the callback never reads what is being written
+    for (auto position = readStart; position < readEnd;)
+    {
+        const int ringIndex = (int) (position % bufferSize);
+        const int numSamples = (int) juce::jmin(readEnd - position, (juce::int64) (bufferSize - ringIndex));
+
+        source->setNextReadPosition(position);
+        source->getNextAudioBlock(juce::AudioSourceChannelInfo(&buffer, ringIndex, numSamples));
+        position += numSamples;
+    }
+
+    // Seeks hold readLock, so nothing else has moved the range meanwhile
+    const juce::SpinLock::ScopedLockType sl(rangeLock);
+    validEnd = readEnd;
+
+    return true;
+}
+
+void ReadAheadAudioSource::prefill()
+{
+    const juce::ScopedLock rl(readLock);
+
+    for (;;)
+    {
+        juce::int64 bufferedAhead = 0;
+
+        {
+            const juce::SpinLock::ScopedLockType sl(rangeLock);
+            bufferedAhead = validEnd - nextPlayPosition.load();
+        }
+
+        if (bufferedAhead >= prefillSize || ! readNextChunk())
+            break;
+    }
+}
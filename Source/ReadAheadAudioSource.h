@@ -0,0 +1,84 @@
+/*
+  ==============================================================================
+
+    ReadAheadAudioSource.h
+    Created: 17 Oct 2026 11:41:37pm
+    Author:  Leif Rehtanz
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+// Keeps a ring buffer of the source's upcoming samples filled from a
+// TimeSliceThread, so the audio callback only ever copies from memory. Unlike
+// juce::BufferingAudioSource the callback never blocks: it takes the range
+// bookkeeping with a try-lock, and whatever isn't buffered yet plays as
+// silence and counts as an underrun. A seek outside the buffered range
+// refills the first prefillSamples on the seeking thread, so playback resumes
+// straight away instead of starting with an underrun.
+class ReadAheadAudioSource : public juce::PositionableAudioSource,
+                             private juce::TimeSliceClient
+{
+public:
+    ReadAheadAudioSource(juce::PositionableAudioSource* sourceToUse,
+                         bool deleteSourceWhenDeleted,
+                         juce::TimeSliceThread& readThreadToUse,
+                         int bufferSizeSamples,
+                         int prefillSamples,
+                         int numChannelsToBuffer = 2);
+
+    ~ReadAheadAudioSource() override;
+
+    // Allocates the buffer and fills the first prefillSamples
+    void prepareToPlay(int samplesPerBlockExpected, double sampleRate) override;
+    void releaseResources() override;
+
+    // Real-time safe
+    void getNextAudioBlock(const juce::AudioSourceChannelInfo& info) override;
+
+    void setNextReadPosition(juce::int64 newPosition) override;
+    juce::int64 getNextReadPosition() const override;
+    juce::int64 getTotalLength() const override   { return source->getTotalLength(); }
+    bool isLooping() const override               { return source->isLooping(); }
+    void setLooping(bool shouldLoop) override     { source->setLooping(shouldLoop); }
+
+    int getBufferSize() const noexcept            { return bufferSize; }
+
+    // Callbacks that had to play silence, and how many samples they were short
+    int getNumUnderruns() const noexcept                  { return numUnderruns.load(); }
+    juce::int64 getNumUnderrunSamples() const noexcept    { return numUnderrunSamples.load(); }
+    void resetUnderrunCount() noexcept;
+
+private:
+    int useTimeSlice() override;
+
+    // Reads the next chunk into the ring; false if the buffer was already full
+    bool readNextChunk();
+    void prefill();
+
+    juce::OptionalScopedPointer<juce::PositionableAudioSource> source;
+    juce::TimeSliceThread& readThread;
+    const int bufferSize, prefillSize, numChannels;
+
+    // Sample n of the source lives at n % bufferSize
+    juce::AudioBuffer<float> buffer;
+    bool isPrepared = false;
+
+    // Buffered range of the source; the read thread only writes outside it
+    juce::SpinLock rangeLock;
+    juce::int64 validStart = 0, validEnd = 0;
+
+    std::atomic<juce::int64> nextPlayPosition { 0 };
+    std::atomic<bool> isSeeking { false };
+
+    // Serialises source reads between the read thread and a prefill
+    juce::CriticalSection readLock;
+
+    std::atomic<int> numUnderruns { 0 };
+    std::atomic<juce::int64> numUnderrunSamples { 0 };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ReadAheadAudioSource)
+};
@@ -0,0 +1,93 @@
+/*
+  ==============================================================================
+
+    RealtimeAllocationChecker.cpp
+    Created: 17 Oct 2026 9:12:40am
+    Author:  Leif Rehtanz
+
+  ==============================================================================
+*/
+
+#include "RealtimeAllocationChecker.h"
+
+#if DEESSDOCTOR_CHECK_REALTIME_ALLOCATIONS
+
+#include <cstdlib>
+#include <new>
+
+namespace
+{
+    thread_local int realtimeDepth = 0;
+    std::atomic<int> numViolations { 0 };
+
+    void checkRealtimeAllocation()
+    {
+        if (realtimeDepth == 0)
+            return;
+
+        ++numViolations;
+
+        // Reporting the assertion may allocate itself, so step out of the section first
+        const int savedDepth = std::exchange(realtimeDepth, 0);
+        jassertfalse; // The audio path allocated or freed memory while processing
+        realtimeDepth = savedDepth;
+    }
+
+    void* checkedAllocate(std::size_t size)
+    {
+        checkRealtimeAllocation();
+        return std::malloc(size == 0 ? 1 : size);
+    }
+
+    void checkedFree(void* ptr) noexcept
+    {
+        if (ptr != nullptr)
+            checkRealtimeAllocation();
+
+        std::free(ptr);
+    }
+}
+
+void* operator new(std::size_t size)
+{
+    if (auto* ptr = checkedAllocate(size))
+        return ptr;
+
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size)
+{
+    if (auto* ptr = checkedAllocate(size))
+        return ptr;
+
+    throw std::bad_alloc();
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept         { return checkedAllocate(size); }
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept       { return checkedAllocate(size); }
+void operator delete(void* ptr) noexcept                                     { checkedFree(ptr); }
+void operator delete[](void* ptr) noexcept                                   { checkedFree(ptr); }
+void operator delete(void* ptr, std::size_t) noexcept                        { checkedFree(ptr); }
+void operator delete[](void* ptr, std::size_t) noexcept                      { checkedFree(ptr); }
+void operator delete(void* ptr, const std::nothrow_t&) noexcept              { checkedFree(ptr); }
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept            { checkedFree(ptr); }
+
+namespace RealtimeAllocationChecker
+{
+    ScopedRealtimeSection::ScopedRealtimeSection()  { ++realtimeDepth; }
+    ScopedRealtimeSection::~ScopedRealtimeSection() { --realtimeDepth; }
+
+    int getNumViolations()  { return numViolations.load(); }
+    void resetViolations()  { numViolations = 0; }
+}
+
+#else
+
+namespace RealtimeAllocationChecker
+{
+    int getNumViolations()  { return 0; }
+    void resetViolations()  {}
+}
+
+#endif
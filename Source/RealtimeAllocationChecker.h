@@ -0,0 +1,43 @@
+/*
+  ==============================================================================
+
+    RealtimeAllocationChecker.h
+    Created: 17 Oct 2026 9:12:40am
+    Author:  Leif Rehtanz
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+// Test mode for the audio path. Build with DEESSDOCTOR_CHECK_REALTIME_ALLOCATIONS=1
+// to replace the global operator new/delete: any allocation or free made on a
+// thread that is inside a ScopedRealtimeSection is counted and hits a jassert.
+// With the flag off (the default) the scope compiles away to nothing.
+#ifndef DEESSDOCTOR_CHECK_REALTIME_ALLOCATIONS
+ #define DEESSDOCTOR_CHECK_REALTIME_ALLOCATIONS 0
+#endif
+
+namespace RealtimeAllocationChecker
+{
+    // Marks the current thread as running real-time code for its lifetime
+    class ScopedRealtimeSection
+    {
+    public:
+       #if DEESSDOCTOR_CHECK_REALTIME_ALLOCATIONS
+        ScopedRealtimeSection();
+        ~ScopedRealtimeSection();
+       #else
+        ScopedRealtimeSection() = default;
+       #endif
+
+        JUCE_DECLARE_NON_COPYABLE(ScopedRealtimeSection)
+    };
+
+    // Number of allocations and frees seen inside real-time sections so far.
+    // Always 0 when the checker is compiled out.
+    int getNumViolations();
+    void resetViolations();
+}
@@ -0,0 +1,309 @@
+/*
+  ==============================================================================
+
+    SibilantAnalyser.cpp
+    Created: 18 Oct 2026 12:27:51am
+    Author:  Leif Rehtanz
+
+  ==============================================================================
+*/
+
+#include "SibilantAnalyser.h"
+
+SibilantAnalyser::SibilantAnalyser()
+    : juce::Thread("Sibilant analysis"),
+      index(std::make_shared<SibilantRegionIndex>())
+{
+    startThread(juce::Thread::Priority::low);
+}
+
+SibilantAnalyser::~SibilantAnalyser()
+{
+    signalThreadShouldExit();
+    notify();
+    stopThread(2000);
+}
+
+void SibilantAnalyser::setFile(const MappedAudioFile& audioFile)
+{
+    {
+        const juce::ScopedLock sl(readerLock);
+        reader = audioFile.createReader();
+        ++fileGeneration;
+    }
+
+    complete = false;
+    notify();
+}
+
+void SibilantAnalyser::setParameters(float newThresholdDb, float newFrequency, int newHysteresisSamples)
+{
+    thresholdDb.store(newThresholdDb);
+    frequency.store(newFrequency);
+    hysteresis.store(newHysteresisSamples);
+
+    complete = false;
+    notify();
+}
+
+std::shared_ptr<const SibilantRegionIndex> SibilantAnalyser::getIndex() const
+{
+    const juce::SpinLock::ScopedLockType sl(indexLock);
+    return index;
+}
+
+std::shared_ptr<const BandPeakPyramid> SibilantAnalyser::getBandPeaks() const
+{
+    const juce::SpinLock::ScopedLockType sl(indexLock);
+    return bandPeaks;
+}
+
+SibilantAnalyser::Parameters SibilantAnalyser::getRequestedParameters() const
+{
+    // Clamped the way AudioProcessorManager clamps them
+    Parameters parameters;
+    parameters.threshold = juce::Decibels::decibelsToGain(thresholdDb.load());
+    parameters.frequency = juce::jlimit(20.0f, (float) (sampleRate.load() * 0.49), frequency.load());
+    parameters.hysteresis = juce::jmax(1, hysteresis.load());
+    return parameters;
+}
+
+void SibilantAnalyser::run()
+{
+    while (! threadShouldExit())
+    {
+        bool didWork = false;
+
+        {
+            const juce::ScopedLock sl(readerLock);
+
+            if (analysedGeneration != fileGeneration)
+                startFile();
+
+            if (reader != nullptr)
+                didWork = updateNextStretch(getRequestedParameters());
+        }
+
+        // Sleep until a new file or new parameters arrive
+        if (! didWork)
+            wait(-1);
+    }
+}
+
+void SibilantAnalyser::startFile()
+{
+    analysedGeneration = fileGeneration;
+    stretches.clear();
+    firstUnchecked = 0;
+    complete = false;
+
+    numChannels = reader != nullptr ? (int) reader->numChannels : 0;
+    sampleRate = reader != nullptr ? reader->sampleRate : 0.0;
+
+    lengthInSamples = reader != nullptr ? juce::jmax((juce::int64) 0, reader->lengthInSamples) : 0;
+
+    if (numChannels > 0)
+    {
+        crossover.prepare({ sampleRate.load(), (juce::uint32) stretchSize, (juce::uint32) numChannels });
+
+        inputBuffer.setSize(numChannels, stretchSize);
+        fullBandBuffer.setSize(numChannels, stretchSize);
+        highBandBuffer.setSize(numChannels, stretchSize);
+        envelope.resize((size_t) stretchSize);
+
+        stretches.resize((size_t) ((lengthInSamples + stretchSize - 1) / stretchSize));
+        blockPeaks.assign((size_t) ((lengthInSamples + BandPeakPyramid::samplesPerBlock - 1) / BandPeakPyramid::samplesPerBlock), 0.0f);
+
+        // The first stretch starts from silence, whatever the cutoff
+        if (! stretches.empty())
+        {
+            stretches.front().filterState.assign(crossover.getStateSize(), 0.0f);
+            stretches.front().hasState = true;
+        }
+    }
+
+    {
+        const juce::SpinLock::ScopedLockType sl(indexLock);
+        bandPeaks.reset();
+    }
+
+    publishedPeaksFrequency = 0.0f;
+    publishIndex(getRequestedParameters());
+}
+
+bool SibilantAnalyser::updateNextStretch(const Parameters& parameters)
+{
+    // New parameters: every stretch has to be looked at again
+    if (parameters != checkedParameters)
+    {
+        checkedParameters = parameters;
+        firstUnchecked = 0;
+        complete = false;
+    }
+
+    for (; firstUnchecked < stretches.size(); ++firstUnchecked)
+    {
+        auto& stretch = stretches[firstUnchecked];
+
+        if (stretch.isAnalysed && stretch.analysedWith == parameters)
+            continue;
+
+        // Below the threshold before and after: still no triggers, and the
+        // audio doesn't need to be touched
+        if (stretch.isAnalysed
+             && stretch.analysedWith.frequency == parameters.frequency
+             && stretch.spans.empty()
+             && stretch.peak <= parameters.threshold)
+        {
+            stretch.analysedWith = parameters;
+            continue;
+        }
+
+        // Stretches are visited in order, so the previous one has already
+        // handed this one its state for the current cutoff
+        jassert(firstUnchecked == 0 || (stretch.hasState && stretch.stateFrequency == parameters.frequency));
+
+        analyseStretch(firstUnchecked++, parameters);
+
+        // Republish now and then, so the display fills in during long passes
+        if (juce::Time::getMillisecondCounter() - lastPublishTime > 250)
+            publishIndex(parameters);
+
+        return true;
+    }
+
+    if (! complete)
+    {
+        // Every stretch now has peaks for this frequency: either it was
+        // filtered with it, or it was skipped because it already had been
+        if (publishedPeaksFrequency != parameters.frequency && ! stretches.empty())
+        {
+            auto newPeaks = std::make_shared<const BandPeakPyramid>(blockPeaks, lengthInSamples, parameters.frequency);
+            publishedPeaksFrequency = parameters.frequency;
+
+            const juce::SpinLock::ScopedLockType sl(indexLock);
+            bandPeaks.swap(newPeaks);
+        }
+
+        publishIndex(parameters);
+        complete = true;
+    }
+
+    return false;
+}
+
+void SibilantAnalyser::analyseStretch(size_t stretchIndex, const Parameters& parameters)
+{
+    auto& stretch = stretches[stretchIndex];
+    const auto start = (juce::int64) stretchIndex * stretchSize;
+    const int numSamples = (int) juce::jmin((juce::int64) stretchSize, lengthInSamples - start);
+
+    // Unreadable sections analyse as silence
+    if (! reader->read(&inputBuffer, 0, numSamples, start, true, true))
+        inputBuffer.clear();
+
+    if (crossover.getCutoffFrequency() != parameters.frequency)
+        crossover.setCutoffFrequency(parameters.frequency);
+
+    crossover.copyStateFrom(stretch.filterState.data());
+
+    juce::dsp::AudioBlock<const float> inputBlock(inputBuffer.getArrayOfReadPointers(), (size_t) numChannels,
+                                                  (size_t) 0, (size_t) numSamples);
+    juce::dsp::AudioBlock<float> fullBandBlock(fullBandBuffer);
+    juce::dsp::AudioBlock<float> highBandBlock(highBandBuffer);
+    crossover.processCrossover(inputBlock, fullBandBlock, highBandBlock);
+
+    // Hand the end state on, unless the next stretch already has it
+    if (stretchIndex + 1 < stretches.size())
+    {
+        auto& next = stretches[stretchIndex + 1];
+
+        if (! next.hasState || next.stateFrequency != parameters.frequency)
+        {
+            next.filterState.resize(crossover.getStateSize());
+            crossover.copyStateTo(next.filterState.data());
+            next.stateFrequency = parameters.frequency;
+            next.hasState = true;
+        }
+    }
+
+    // A sample triggers the gate if any channel's high band is above the
+    // threshold; the full band buffer is free to hold the magnitudes
+    juce::FloatVectorOperations::abs(envelope.data(), highBandBuffer.getReadPointer(0), numSamples);
+
+    for (int channel = 1; channel < numChannels; ++channel)
+    {
+        auto* magnitudes = fullBandBuffer.getWritePointer(channel);
+        juce::FloatVectorOperations::abs(magnitudes, highBandBuffer.getReadPointer(channel), numSamples);
+        juce::FloatVectorOperations::max(envelope.data(), envelope.data(), magnitudes, numSamples);
+    }
+
+    stretch.peak = juce::FloatVectorOperations::findMaximum(envelope.data(), numSamples);
+
+    if (stretch.peaksFrequency != parameters.frequency)
+    {
+        constexpr int blockSize = BandPeakPyramid::samplesPerBlock;
+        auto* peaks = blockPeaks.data() + start / blockSize;
+
+        for (int i = 0; i < numSamples; i += blockSize)
+            peaks[i / blockSize] = juce::FloatVectorOperations::findMaximum(envelope.data() + i, juce::jmin(blockSize, numSamples - i));
+
+        stretch.peaksFrequency = parameters.frequency;
+    }
+    stretch.spans.clear();
+
+    // A trigger holds the gate open for hysteresis samples, so triggers that
+    // close enough together belong to one region
+    if (stretch.peak > parameters.threshold)
+    {
+        for (int i = 0; i < numSamples; ++i)
+        {
+            if (envelope[(size_t) i] <= parameters.threshold)
+                continue;
+
+            const auto sample = start + i;
+
+            if (! stretch.spans.empty() && sample <= stretch.spans.back().endSample - 1 + parameters.hysteresis)
+                stretch.spans.back().endSample = sample + 1;
+            else
+                stretch.spans.push_back({ sample, sample + 1 });
+        }
+    }
+
+    stretch.analysedWith = parameters;
+    stretch.isAnalysed = true;
+}
+
+void SibilantAnalyser::publishIndex(const Parameters& parameters)
+{
+    // Spans join across stretch boundaries by the same rule as within one,
+    // then each region gets its hysteresis tail
+    std::vector<SibilantRegion> regions;
+
+    for (const auto& stretch : stretches)
+    {
+        if (! stretch.isAnalysed || stretch.analysedWith != parameters)
+            continue;
+
+        for (const auto& span : stretch.spans)
+        {
+            if (! regions.empty() && span.startSample <= regions.back().endSample - 1 + parameters.hysteresis)
+                regions.back().endSample = span.endSample;
+            else
+                regions.push_back(span);
+        }
+    }
+
+    for (auto& region : regions)
+        region.endSample = juce::jmin(region.endSample - 1 + parameters.hysteresis, lengthInSamples);
+
+    auto newIndex = std::make_shared<const SibilantRegionIndex>(std::move(regions));
+
+    {
+        const juce::SpinLock::ScopedLockType sl(indexLock);
+        index.swap(newIndex);
+    }
+
+    lastPublishTime = juce::Time::getMillisecondCounter();
+    sendChangeMessage();
+}
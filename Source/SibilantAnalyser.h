@@ -0,0 +1,130 @@
+/*
+  ==============================================================================
+
+    SibilantAnalyser.h
+    Created: 18 Oct 2026 12:27:51am
+    Author:  Leif Rehtanz
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "BandPeakPyramid.h"
+#include "MappedAudioFile.h"
+#include "MultichannelLinkwitzRiley.h"
+#include "SibilantRegion.h"
+
+// Runs the amplitude threshold detector over the whole file on a background
+// thread and publishes the sibilant regions it finds as a SibilantRegionIndex,
+// with the same crossover and gate as AudioProcessorManager, so the regions
+// match what playback gates when it starts from the top of the file.
+//
+// The file is analysed in stretches of stretchSize samples. Each stretch
+// remembers the crossover state at its start, its loudest high-band sample
+// and where its triggers are, so a parameter change only goes back to the
+// audio where it could make a difference: a threshold or hysteresis change
+// skips every stretch that stays below the threshold either way and
+// re-filters the rest from their saved state, while a frequency change
+// re-filters the whole file. Regions fill in as stretches finish, and a
+// change message goes out whenever the index has been republished.
+//
+// Each pass with a new frequency also leaves the sibilant band's block peaks
+// behind as a BandPeakPyramid, for previewing thresholds without waiting for
+// the analysis.
+class SibilantAnalyser : public juce::ChangeBroadcaster,
+                         private juce::Thread
+{
+public:
+    static constexpr int stretchSize = 1 << 16;
+
+    SibilantAnalyser();
+    ~SibilantAnalyser() override;
+
+    // Drops every result and analyses the new file from the start; message thread
+    void setFile(const MappedAudioFile& audioFile);
+
+    // Same units as AudioProcessorManager::setDeEssingParameters(); any thread
+    void setParameters(float newThresholdDb, float newFrequency, int newHysteresisSamples);
+
+    // Regions found so far for the latest parameters; never nullptr
+    std::shared_ptr<const SibilantRegionIndex> getIndex() const;
+
+    // Band peaks from the last finished pass, which may be for an earlier
+    // frequency (see BandPeakPyramid::getFrequency()); nullptr until the
+    // first pass over a file has finished
+    std::shared_ptr<const BandPeakPyramid> getBandPeaks() const;
+
+    bool isComplete() const noexcept          { return complete.load(); }
+    double getSampleRate() const noexcept     { return sampleRate.load(); }
+
+private:
+    struct Parameters
+    {
+        float threshold = 0.0f;   // Linear
+        float frequency = 0.0f;
+        int hysteresis = 1;
+
+        bool operator== (const Parameters& other) const noexcept
+        {
+            return threshold == other.threshold && frequency == other.frequency && hysteresis == other.hysteresis;
+        }
+
+        bool operator!= (const Parameters& other) const noexcept  { return ! operator== (other); }
+    };
+
+    struct Stretch
+    {
+        std::vector<float> filterState;    // Crossover state at the first sample
+        float stateFrequency = 0.0f;       // Cutoff filterState belongs to
+        bool hasState = false;
+
+        float peak = 0.0f;                 // Loudest high-band sample of any channel
+        std::vector<SibilantRegion> spans; // First to one past the last trigger
+        float peaksFrequency = 0.0f;       // Cutoff blockPeaks hold this stretch's peaks for
+        Parameters analysedWith;
+        bool isAnalysed = false;
+    };
+
+    void run() override;
+    Parameters getRequestedParameters() const;
+    void startFile();
+
+    // Brings the next out-of-date stretch up to date; false if there was none
+    bool updateNextStretch(const Parameters& parameters);
+    void analyseStretch(size_t index, const Parameters& parameters);
+    void publishIndex(const Parameters& parameters);
+
+    // Only replaced by setFile(), which the analysis thread is locked out of
+    juce::CriticalSection readerLock;
+    std::unique_ptr<juce::AudioFormatReader> reader;
+    int fileGeneration = 0;
+
+    std::atomic<float> thresholdDb { -20.0f };
+    std::atomic<float> frequency { 6500.0f };
+    std::atomic<int> hysteresis { 100 };
+
+    // Analysis thread only
+    int analysedGeneration = -1;
+    int numChannels = 0;
+    juce::int64 lengthInSamples = 0;
+    std::vector<Stretch> stretches;
+    size_t firstUnchecked = 0;
+    Parameters checkedParameters;
+    MultichannelLinkwitzRiley crossover;
+    juce::AudioBuffer<float> inputBuffer, fullBandBuffer, highBandBuffer;
+    std::vector<float> envelope;
+    std::vector<float> blockPeaks;
+    float publishedPeaksFrequency = 0.0f;
+    juce::uint32 lastPublishTime = 0;
+
+    std::atomic<double> sampleRate { 0.0 };
+    std::atomic<bool> complete { false };
+
+    mutable juce::SpinLock indexLock;
+    std::shared_ptr<const SibilantRegionIndex> index;
+    std::shared_ptr<const BandPeakPyramid> bandPeaks;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SibilantAnalyser)
+};
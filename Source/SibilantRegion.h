@@ -1,18 +1,79 @@
-/*
-  ==============================================================================
-
-    SibilantRegion.h
-    Created: 3 Dec 2024 2:55:13pm
-    Author:  Leif Rehtanz
-
-  ==============================================================================
-*/
-
-// SibilantRegion.h
-#pragma once
-
-struct SibilantRegion
-{
-    int startSample;
-    int endSample;
-};
+/*
+  ==============================================================================
+
+    SibilantRegion.h
+    Created: 3 Dec 2024 2:55:13pm
+    Author:  Leif Rehtanz
+
+  ==============================================================================
+*/
+
+// SibilantRegion.h
+#pragma once
+
+#include <JuceHeader.h>
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+struct SibilantRegion
+{
+    juce::int64 startSample;
+    juce::int64 endSample;      // One past the last sibilant sample
+};
+
+// Sorted, non-overlapping regions in one flat array. Since no region overlaps
+// the next, the ends are sorted too, so a binary search on them finds the
+// first region reaching into a range and the rest follow in order.
+class SibilantRegionIndex
+{
+public:
+    using const_iterator = std::vector<SibilantRegion>::const_iterator;
+
+    SibilantRegionIndex() = default;
+
+    // Regions must be sorted and must not overlap
+    explicit SibilantRegionIndex(std::vector<SibilantRegion> sortedRegions)
+        : regions(std::move(sortedRegions))
+    {
+    }
+
+    size_t size() const noexcept                     { return regions.size(); }
+    bool isEmpty() const noexcept                    { return regions.empty(); }
+    const SibilantRegion& operator[](size_t i) const { return regions[i]; }
+
+    // Regions overlapping [startSample, endSample), in O(log n + k)
+    std::pair<const_iterator, const_iterator> getRegionsIn(juce::int64 startSample, juce::int64 endSample) const
+    {
+        const auto first = std::upper_bound(regions.begin(), regions.end(), startSample,
+                                            [](juce::int64 sample, const SibilantRegion& region) { return sample < region.endSample; });
+
+        auto last = first;
+
+        while (last != regions.end() && last->startSample < endSample)
+            ++last;
+
+        return { first, last };
+    }
+
+    // First region starting after sample, or nullptr
+    const SibilantRegion* findNextAfter(juce::int64 sample) const
+    {
+        const auto next = std::upper_bound(regions.begin(), regions.end(), sample,
+                                           [](juce::int64 s, const SibilantRegion& region) { return s < region.startSample; });
+
+        return next != regions.end() ? &*next : nullptr;
+    }
+
+    // Last region starting before sample, or nullptr
+    const SibilantRegion* findPreviousBefore(juce::int64 sample) const
+    {
+        const auto next = std::lower_bound(regions.begin(), regions.end(), sample,
+                                           [](const SibilantRegion& region, juce::int64 s) { return region.startSample < s; });
+
+        return next != regions.begin() ? &*std::prev(next) : nullptr;
+    }
+
+private:
+    std::vector<SibilantRegion> regions;
+};
@@ -0,0 +1,187 @@
+/*
+  ==============================================================================
+
+    SpectralDeEsser.cpp
+    Created: 17 Oct 2026 6:48:03pm
+    Author:  Leif Rehtanz
+
+  ==============================================================================
+*/
+
+#include "SpectralDeEsser.h"
+
+void SpectralDeEsser::prepare(double sampleRate, int numChannels)
+{
+    currentSampleRate = sampleRate;
+
+    const int fftOrder = sampleRate > 100000.0 ? 12 : (sampleRate > 50000.0 ? 11 : 10);
+    fft = std::make_unique<juce::dsp::FFT>(fftOrder);
+    fftSize = fft->getSize();
+    hopSize = fftSize / 4;
+
+    window.resize((size_t) fftSize);
+    windowSquared.resize((size_t) fftSize);
+    windowEnergy = 0.0f;
+
+    // Periodic Hann, so the squared windows of a 75% overlap sum to a constant
+    for (int i = 0; i < fftSize; ++i)
+    {
+        const auto hann = 0.5 - 0.5 * std::cos(juce::MathConstants<double>::twoPi * i / fftSize);
+        window[(size_t) i] = (float) std::sqrt(hann);
+        windowSquared[(size_t) i] = (float) hann;
+        windowEnergy += (float) hann;
+    }
+
+    // Four overlapping Hann windows sum to 2
+    overlapAddScale = (float) hopSize / (0.5f * (float) fftSize);
+
+    fftData.assign((size_t) (2 * fftSize), 0.0f);
+
+    channels.resize((size_t) juce::jmax(0, numChannels));
+
+    for (auto& channel : channels)
+    {
+        channel.input.assign((size_t) fftSize, 0.0f);
+        channel.output.assign((size_t) fftSize, 0.0f);
+    }
+
+    reset();
+}
+
+void SpectralDeEsser::reset()
+{
+    for (auto& channel : channels)
+    {
+        std::fill(channel.input.begin(), channel.input.end(), 0.0f);
+        std::fill(channel.output.begin(), channel.output.end(), 0.0f);
+        channel.holdFrames = 0;
+    }
+
+    position = 0;
+    hopCounter = 0;
+}
+
+void SpectralDeEsser::setParameters(float newThresholdGain, float newSibilantGain, float newFrequency, int newHoldSamples)
+{
+    thresholdGain = newThresholdGain;
+    sibilantGain = newSibilantGain;
+
+    if (fftSize > 0)
+    {
+        const auto bin = (int) std::ceil(newFrequency * fftSize / currentSampleRate);
+        firstSibilantBin = juce::jlimit(1, fftSize / 2, bin);
+        holdFrames = juce::jmax(1, (newHoldSamples + hopSize - 1) / hopSize);
+    }
+}
+
+void SpectralDeEsser::process(juce::AudioBuffer<float>& buffer, int startSample, int numSamples)
+{
+    jassert(fftSize > 0);
+
+    const int numChannels = juce::jmin(buffer.getNumChannels(), (int) channels.size());
+
+    if (numChannels == 0)
+        return;
+
+    // Every channel runs the same sequence of positions and frames, starting
+    // from the shared counters
+    const int startPosition = position;
+    const int startHopCounter = hopCounter;
+
+    for (int channelIndex = 0; channelIndex < numChannels; ++channelIndex)
+    {
+        auto& channel = channels[(size_t) channelIndex];
+        auto* data = buffer.getWritePointer(channelIndex, startSample);
+
+        position = startPosition;
+        hopCounter = startHopCounter;
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            channel.input[(size_t) position] = data[i];
+
+            if (++hopCounter == hopSize)
+            {
+                hopCounter = 0;
+                processFrame(channel, position);
+            }
+
+            // The frame that just ended wrote its oldest sample here, so
+            // everything that overlaps this output sample is now summed in
+            data[i] = channel.output[(size_t) position];
+            channel.output[(size_t) position] = 0.0f;
+
+            if (++position == fftSize)
+                position = 0;
+        }
+    }
+}
+
+void SpectralDeEsser::processFrame(ChannelState& channel, int newestPosition)
+{
+    // Oldest sample first: it sits just after the newest in the circular input
+    const int oldest = newestPosition + 1 == fftSize ? 0 : newestPosition + 1;
+    const auto* input = channel.input.data();
+    auto* data = fftData.data();
+
+    for (int i = 0; i < fftSize; ++i)
+    {
+        const int index = oldest + i < fftSize ? oldest + i : oldest + i - fftSize;
+        data[i] = input[index] * window[(size_t) i];
+    }
+
+    fft->performRealOnlyForwardTransform(data, true);
+
+    // Band RMS by Parseval: each positive-frequency bin stands for two
+    // conjugate bins, and dividing by the window energy undoes the window
+    const int nyquistBin = fftSize / 2;
+    float bandEnergy = 0.0f;
+
+    for (int bin = firstSibilantBin; bin < nyquistBin; ++bin)
+        bandEnergy += data[2 * bin] * data[2 * bin] + data[2 * bin + 1] * data[2 * bin + 1];
+
+    const float bandLevel = std::sqrt(2.0f * bandEnergy / ((float) fftSize * windowEnergy));
+
+    bool isSibilant = false;
+
+    if (bandLevel > thresholdGain)
+    {
+        channel.holdFrames = holdFrames;
+        isSibilant = true;
+    }
+    else if (channel.holdFrames > 0)
+    {
+        --channel.holdFrames;
+        isSibilant = true;
+    }
+
+    // The newest sample of the frame is heard fftSize - 1 samples from now,
+    // its oldest one right away, at the newest input position
+    auto* output = channel.output.data();
+
+    if (isSibilant && sibilantGain != 1.0f)
+    {
+        for (int bin = firstSibilantBin; bin <= nyquistBin; ++bin)
+        {
+            data[2 * bin] *= sibilantGain;
+            data[2 * bin + 1] *= sibilantGain;
+        }
+
+        fft->performRealOnlyInverseTransform(data);
+
+        for (int i = 0; i < fftSize; ++i)
+        {
+            const int index = newestPosition + i < fftSize ? newestPosition + i : newestPosition + i - fftSize;
+            output[index] += data[i] * window[(size_t) i] * overlapAddScale;
+        }
+    }
+    else
+    {
+        for (int i = 0; i < fftSize; ++i)
+        {
+            const int index = newestPosition + i < fftSize ? newestPosition + i : newestPosition + i - fftSize;
+            const int inputIndex = oldest + i < fftSize ? oldest + i : oldest + i - fftSize;
+            output[index] += input[inputIndex] * windowSquared[(size_t) i] * overlapAddScale;
+        }
+    }
+}
@@ -0,0 +1,77 @@
+/*
+  ==============================================================================
+
+    SpectralDeEsser.h
+    Created: 17 Oct 2026 6:48:03pm
+    Author:  Leif Rehtanz
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+// Streaming STFT de-esser: real-only FFTs of sqrt-Hann windowed frames with
+// 75% overlap, resynthesised by overlap-add through the same window. Each
+// frame measures the RMS level of the bins above the sibilant frequency; a
+// frame above the threshold, and the frames within the hold time after it,
+// get those bins scaled by the sibilant gain. Frames that are left alone skip
+// the inverse FFT, since an untouched frame resynthesises to its input.
+//
+// Input is collected sample by sample, so any host block size works, and the
+// output is delayed by a fixed getLatencySamples().
+class SpectralDeEsser
+{
+public:
+    SpectralDeEsser() = default;
+
+    // Builds the FFT plan and every buffer. The FFT size follows the sample
+    // rate so a bin stays roughly 45 Hz wide: 1024 up to 50 kHz, 2048 up to
+    // 100 kHz, 4096 above.
+    void prepare(double sampleRate, int numChannels);
+
+    // Clears the overlap-add history and the hold counters. Real-time safe.
+    void reset();
+
+    // Real-time safe. Gains are linear; holdSamples is rounded up to whole hops.
+    void setParameters(float newThresholdGain, float newSibilantGain, float newFrequency, int newHoldSamples);
+
+    // Real-time safe, in place. Channels beyond the prepared count pass through.
+    void process(juce::AudioBuffer<float>& buffer, int startSample, int numSamples);
+
+    int getLatencySamples() const noexcept  { return juce::jmax(0, fftSize - 1); }
+    int getFFTSize() const noexcept         { return fftSize; }
+
+private:
+    struct ChannelState
+    {
+        std::vector<float> input;   // Last fftSize input samples, circular
+        std::vector<float> output;  // Overlap-add accumulator, circular
+        int holdFrames = 0;
+    };
+
+    void processFrame(ChannelState& channel, int newestPosition);
+
+    std::unique_ptr<juce::dsp::FFT> fft;
+    int fftSize = 0;
+    int hopSize = 0;
+    double currentSampleRate = 44100.0;
+
+    std::vector<float> window;        // sqrt-Hann, for analysis and synthesis
+    std::vector<float> windowSquared; // Pass-through path for untouched frames
+    std::vector<float> fftData;       // 2 * fftSize, as the real-only transforms need
+    float windowEnergy = 0.0f;
+    float overlapAddScale = 0.0f;
+
+    std::vector<ChannelState> channels;
+    int position = 0;   // Shared by all channels; they always advance together
+    int hopCounter = 0;
+
+    float thresholdGain = 0.1f;
+    float sibilantGain = 1.0f;
+    int firstSibilantBin = 1;
+    int holdFrames = 1;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SpectralDeEsser)
+};
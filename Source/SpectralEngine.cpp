@@ -0,0 +1,52 @@
+/*
+  ==============================================================================
+
+    SpectralEngine.cpp
+    Created: 18 Oct 2026 1:48:22am
+    Author:  Leif Rehtanz
+
+  ==============================================================================
+*/
+
+#include "SpectralEngine.h"
+
+void SpectralEngine::prepare(double sampleRate, int /*maximumBlockSize*/, int numChannels)
+{
+    // Collects its input sample by sample, so any block size works
+    currentSampleRate = sampleRate;
+    deEsser.prepare(sampleRate, numChannels);
+    applyParameters();
+}
+
+void SpectralEngine::reset()
+{
+    deEsser.reset();
+}
+
+void SpectralEngine::setParameters(float newThresholdDb, float newMixDb, float newFrequency, int newHysteresisSamples)
+{
+    if (newThresholdDb == thresholdDb && newMixDb == mixDb
+         && newFrequency == frequency && newHysteresisSamples == hysteresisSamples)
+        return;
+
+    thresholdDb = newThresholdDb;
+    mixDb = newMixDb;
+    frequency = newFrequency;
+    hysteresisSamples = newHysteresisSamples;
+
+    if (currentSampleRate > 0.0)
+        applyParameters();
+}
+
+void SpectralEngine::applyParameters()
+{
+    deEsser.setParameters(juce::Decibels::decibelsToGain(thresholdDb),
+                          juce::Decibels::decibelsToGain(mixDb),
+                          juce::jlimit(20.0f, (float) (currentSampleRate * 0.49), frequency),
+                          juce::jmax(1, hysteresisSamples));
+}
+
+void SpectralEngine::process(juce::AudioBuffer<float>& buffer, int startSample, int numSamples)
+{
+    deEsser.process(buffer, startSample, numSamples);
+}
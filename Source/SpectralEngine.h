@@ -0,0 +1,43 @@
+/*
+  ==============================================================================
+
+    SpectralEngine.h
+    Created: 18 Oct 2026 1:48:22am
+    Author:  Leif Rehtanz
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "DeEssEngine.h"
+#include "SpectralDeEsser.h"
+
+// SpectralDeEsser as an engine. It works per frame, so parameter changes
+// apply at the next frame instead of ramping; the 75% frame overlap smooths
+// them instead. Delayed by the FFT size.
+class SpectralEngine : public DeEssEngine
+{
+public:
+    SpectralEngine() = default;
+
+    void prepare(double sampleRate, int maximumBlockSize, int numChannels) override;
+    void reset() override;
+    void setParameters(float thresholdDb, float mixDb, float frequency, int hysteresisSamples) override;
+    void process(juce::AudioBuffer<float>& buffer, int startSample, int numSamples) override;
+    int getLatencySamples() const override  { return deEsser.getLatencySamples(); }
+
+private:
+    void applyParameters();
+
+    SpectralDeEsser deEsser;
+    double currentSampleRate = 0.0;
+
+    float thresholdDb = -20.0f;
+    float mixDb = 0.0f;
+    float frequency = 6500.0f;
+    int hysteresisSamples = 100;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SpectralEngine)
+};
@@ -0,0 +1,58 @@
+/*
+  ==============================================================================
+
+    SpectrumFifo.cpp
+    Created: 17 Oct 2026 7:55:26pm
+    Author:  Leif Rehtanz
+
+  ==============================================================================
+*/
+
+#include "SpectrumFifo.h"
+
+SpectrumFifo::SpectrumFifo(int capacityInSamples)
+    : fifo(capacityInSamples),
+      samples((size_t) capacityInSamples, 0.0f)
+{
+}
+
+void SpectrumFifo::push(const juce::AudioBuffer<float>& buffer, int numChannels, int startSample, int numSamples) noexcept
+{
+    numChannels = juce::jmin(numChannels, buffer.getNumChannels());
+
+    if (numChannels <= 0)
+        return;
+
+    const float channelGain = 1.0f / (float) numChannels;
+    const auto scope = fifo.write(numSamples);
+
+    // The ready region comes in up to two pieces when it wraps around
+    auto mixInto = [&] (int destStart, int count, int sourceOffset)
+    {
+        auto* dest = samples.data() + destStart;
+
+        juce::FloatVectorOperations::copyWithMultiply(dest, buffer.getReadPointer(0, startSample + sourceOffset), channelGain, count);
+
+        for (int channel = 1; channel < numChannels; ++channel)
+            juce::FloatVectorOperations::addWithMultiply(dest, buffer.getReadPointer(channel, startSample + sourceOffset), channelGain, count);
+    };
+
+    if (scope.blockSize1 > 0)
+        mixInto(scope.startIndex1, scope.blockSize1, 0);
+
+    if (scope.blockSize2 > 0)
+        mixInto(scope.startIndex2, scope.blockSize2, scope.blockSize1);
+}
+
+int SpectrumFifo::pop(float* dest, int maxSamples) noexcept
+{
+    const auto scope = fifo.read(juce::jmin(maxSamples, fifo.getNumReady()));
+
+    if (scope.blockSize1 > 0)
+        std::copy_n(samples.data() + scope.startIndex1, scope.blockSize1, dest);
+
+    if (scope.blockSize2 > 0)
+        std::copy_n(samples.data() + scope.startIndex2, scope.blockSize2, dest + scope.blockSize1);
+
+    return scope.blockSize1 + scope.blockSize2;
+}
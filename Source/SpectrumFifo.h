@@ -0,0 +1,40 @@
+/*
+  ==============================================================================
+
+    SpectrumFifo.h
+    Created: 17 Oct 2026 7:55:26pm
+    Author:  Leif Rehtanz
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+// Single-producer/single-consumer ring buffer that carries a mono mixdown of
+// the input from the audio thread to the spectrum analyser thread. Pushing is
+// wait-free: when the analyser has fallen behind, whatever doesn't fit is
+// dropped instead of waiting for room.
+class SpectrumFifo
+{
+public:
+    explicit SpectrumFifo(int capacityInSamples = 1 << 15);
+
+    // Audio thread. Averages the first numChannels channels of the range.
+    void push(const juce::AudioBuffer<float>& buffer, int numChannels, int startSample, int numSamples) noexcept;
+
+    // Analyser thread. Returns the number of samples copied into dest.
+    int pop(float* dest, int maxSamples) noexcept;
+
+    // Set from prepareToPlay(), read by the analyser to place its bins
+    void setSampleRate(double newSampleRate) noexcept  { sampleRate.store(newSampleRate); }
+    double getSampleRate() const noexcept              { return sampleRate.load(); }
+
+private:
+    juce::AbstractFifo fifo;
+    std::vector<float> samples;
+    std::atomic<double> sampleRate { 44100.0 };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SpectrumFifo)
+};
@@ -1,11 +1,186 @@
-/*
-  ==============================================================================
-
-    SpectrumOverlay.cpp
-    Created: 18 Nov 2024 12:08:49pm
-    Author:  Leif Rehtanz
-
-  ==============================================================================
-*/
-
-#include "SpectrumOverlay.h"
+/*
+  ==============================================================================
+
+    SpectrumOverlay.cpp
+    Created: 18 Nov 2024 12:08:49pm
+    Author:  Leif Rehtanz
+
+  ==============================================================================
+*/
+
+#include "SpectrumOverlay.h"
+
+SpectrumOverlay::SpectrumOverlay(SpectrumFifo& fifoToUse)
+    : juce::Thread("Spectrum analyser"),
+      fifo(fifoToUse),
+      history((size_t) fftSize, 0.0f),
+      fftData((size_t) (2 * fftSize), 0.0f),
+      smoothedLevels((size_t) numPoints, 0.0f),
+      publishedLevels((size_t) numPoints, 0.0f),
+      displayLevels((size_t) numPoints, 0.0f),
+      vBlankAttachment(this, [this] { updateFromAnalyser(); })
+{
+    setOpaque(true);
+    setInterceptsMouseClicks(false, false);
+
+    startThread(juce::Thread::Priority::low);
+}
+
+SpectrumOverlay::~SpectrumOverlay()
+{
+    stopThread(1000);
+}
+
+void SpectrumOverlay::setCrossoverFrequency(float newFrequency)
+{
+    if (newFrequency != crossoverFrequency)
+    {
+        crossoverFrequency = newFrequency;
+        repaint(getSpectrumArea());
+    }
+}
+
+void SpectrumOverlay::run()
+{
+    while (! threadShouldExit())
+    {
+        // Fill the newest hop at the end of the history
+        auto* newest = history.data() + fftSize - hopSize;
+        numPendingSamples += fifo.pop(newest + numPendingSamples, hopSize - numPendingSamples);
+
+        if (numPendingSamples < hopSize)
+        {
+            // Nothing queued; a 10 ms nap still keeps up with any display
+            wait(10);
+            continue;
+        }
+
+        analyseFrame();
+
+        std::copy(history.begin() + hopSize, history.end(), history.begin());
+        numPendingSamples = 0;
+    }
+}
+
+void SpectrumOverlay::analyseFrame()
+{
+    std::copy(history.begin(), history.end(), fftData.begin());
+    window.multiplyWithWindowingTable(fftData.data(), (size_t) fftSize);
+    fft.performFrequencyOnlyForwardTransform(fftData.data(), true);
+
+    const double sampleRate = fifo.getSampleRate();
+    const double nyquist = sampleRate * 0.5;
+    const auto binsPerHz = fftSize / sampleRate;
+    const int maxBin = fftSize / 2;
+
+    // A full-scale sine peaks at fftSize / 4 through a Hann window
+    const float magnitudeToGain = 4.0f / (float) fftSize;
+
+    auto pointFrequency = [&] (double point)
+    {
+        return minFrequency * std::pow(nyquist / minFrequency, point / (numPoints - 1));
+    };
+
+    for (int point = 0; point < numPoints; ++point)
+    {
+        // Points are log-spaced, so high ones cover many bins: take the loudest
+        const int firstBin = juce::jlimit(0, maxBin, (int) std::floor(pointFrequency(point - 0.5) * binsPerHz));
+        const int lastBin = juce::jlimit(firstBin, maxBin, (int) std::ceil(pointFrequency(point + 0.5) * binsPerHz));
+
+        float magnitude = 0.0f;
+
+        for (int bin = firstBin; bin <= lastBin; ++bin)
+            magnitude = juce::jmax(magnitude, fftData[(size_t) bin]);
+
+        const auto decibels = juce::Decibels::gainToDecibels(magnitude * magnitudeToGain, minDecibels);
+        const auto level = juce::jmap(decibels, minDecibels, 0.0f, 0.0f, 1.0f);
+
+        // Instant attack, exponential release
+        auto& smoothed = smoothedLevels[(size_t) point];
+        smoothed = level > smoothed ? level : smoothed * releaseCoefficient + level * (1.0f - releaseCoefficient);
+    }
+
+    {
+        const juce::SpinLock::ScopedLockType lock(levelsLock);
+        publishedLevels = smoothedLevels;
+        publishedSampleRate = sampleRate;
+    }
+
+    newLevelsReady.store(true);
+}
+
+void SpectrumOverlay::updateFromAnalyser()
+{
+    if (! newLevelsReady.exchange(false))
+        return;
+
+    {
+        const juce::SpinLock::ScopedLockType lock(levelsLock);
+        displayLevels = publishedLevels;
+        displaySampleRate = publishedSampleRate;
+    }
+
+    repaint(getSpectrumArea());
+}
+
+juce::Rectangle<int> SpectrumOverlay::getSpectrumArea() const
+{
+    return getLocalBounds().reduced(4).withTrimmedBottom(labelHeight);
+}
+
+float SpectrumOverlay::frequencyToProportion(float frequency) const
+{
+    const auto nyquist = (float) displaySampleRate * 0.5f;
+    return std::log(juce::jmax(minFrequency, frequency) / minFrequency) / std::log(nyquist / minFrequency);
+}
+
+void SpectrumOverlay::paint(juce::Graphics& g)
+{
+    g.fillAll(juce::Colours::black);
+
+    const auto area = getSpectrumArea().toFloat();
+
+    // Decade grid with labels underneath
+    g.setFont(11.0f);
+
+    for (float frequency : { 100.0f, 1000.0f, 10000.0f })
+    {
+        const auto x = area.getX() + frequencyToProportion(frequency) * area.getWidth();
+
+        g.setColour(juce::Colours::darkgrey);
+        g.drawVerticalLine(juce::roundToInt(x), area.getY(), area.getBottom());
+        g.setColour(juce::Colours::grey);
+        g.drawText(frequency >= 1000.0f ? juce::String((int) frequency / 1000) + "k" : juce::String((int) frequency),
+                   juce::Rectangle<float>(x - 20.0f, area.getBottom(), 40.0f, (float) labelHeight),
+                   juce::Justification::centred);
+    }
+
+    juce::Path spectrum;
+    spectrum.startNewSubPath(area.getBottomLeft());
+
+    for (int point = 0; point < numPoints; ++point)
+        spectrum.lineTo(area.getX() + area.getWidth() * (float) point / (float) (numPoints - 1),
+                        area.getBottom() - area.getHeight() * displayLevels[(size_t) point]);
+
+    spectrum.lineTo(area.getBottomRight());
+    spectrum.closeSubPath();
+
+    g.setColour(juce::Colours::lightblue.withAlpha(0.4f));
+    g.fillPath(spectrum);
+
+    // The same curve, shaded from the crossover up
+    const auto crossoverX = area.getX() + frequencyToProportion(crossoverFrequency) * area.getWidth();
+
+    {
+        juce::Graphics::ScopedSaveState saveState(g);
+        g.reduceClipRegion(area.withLeft(crossoverX).toNearestInt());
+        g.setColour(juce::Colours::orange.withAlpha(0.6f));
+        g.fillPath(spectrum);
+    }
+
+    g.setColour(juce::Colours::lightblue);
+    g.strokePath(spectrum, juce::PathStrokeType(1.0f));
+
+    g.setColour(juce::Colours::orange);
+    g.drawVerticalLine(juce::roundToInt(crossoverX), area.getY(), area.getBottom());
+}
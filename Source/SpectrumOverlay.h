@@ -1,11 +1,75 @@
-/*
-  ==============================================================================
-
-    SpectrumOverlay.h
-    Created: 18 Nov 2024 12:08:49pm
-    Author:  Leif Rehtanz
-
-  ==============================================================================
-*/
-
-#pragma once
+/*
+  ==============================================================================
+
+    SpectrumOverlay.h
+    Created: 18 Nov 2024 12:08:49pm
+    Author:  Leif Rehtanz
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "SpectrumFifo.h"
+
+// Live spectrum of the input with the sibilant band, everything above the
+// crossover frequency, shaded on top. The audio thread only feeds the FIFO;
+// a background thread runs the FFTs and the level smoothing and hands the
+// finished curve over. The component repaints at most once per display
+// refresh, only when a new curve has arrived, and only the plot area.
+class SpectrumOverlay : public juce::Component,
+                        private juce::Thread
+{
+public:
+    explicit SpectrumOverlay(SpectrumFifo& fifoToUse);
+    ~SpectrumOverlay() override;
+
+    // Where the shaded sibilant band starts
+    void setCrossoverFrequency(float newFrequency);
+
+    void paint(juce::Graphics& g) override;
+
+private:
+    static constexpr int fftOrder = 11;
+    static constexpr int fftSize = 1 << fftOrder;
+    static constexpr int hopSize = fftSize / 4;
+    static constexpr int numPoints = 256;
+    static constexpr float minFrequency = 20.0f;
+    static constexpr float minDecibels = -100.0f;
+    static constexpr float releaseCoefficient = 0.85f;
+    static constexpr int labelHeight = 14;
+
+    // Analyser thread
+    void run() override;
+    void analyseFrame();
+
+    // Message thread
+    void updateFromAnalyser();
+    juce::Rectangle<int> getSpectrumArea() const;
+    float frequencyToProportion(float frequency) const;
+
+    SpectrumFifo& fifo;
+
+    // Owned by the analyser thread
+    juce::dsp::FFT fft { fftOrder };
+    juce::dsp::WindowingFunction<float> window { (size_t) fftSize, juce::dsp::WindowingFunction<float>::hann, false };
+    std::vector<float> history;        // fftSize samples, the newest hop arriving at the end
+    std::vector<float> fftData;        // 2 * fftSize for the real-only transform
+    std::vector<float> smoothedLevels; // One per point, 0 at minDecibels to 1 at 0 dB
+    int numPendingSamples = 0;
+
+    // Handed from the analyser to the message thread
+    juce::SpinLock levelsLock;
+    std::vector<float> publishedLevels;
+    double publishedSampleRate = 44100.0;
+    std::atomic<bool> newLevelsReady { false };
+
+    // Owned by the message thread
+    std::vector<float> displayLevels;
+    double displaySampleRate = 44100.0;
+    float crossoverFrequency = 6500.0f;
+    juce::VBlankAttachment vBlankAttachment;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SpectrumOverlay)
+};
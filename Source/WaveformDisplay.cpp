@@ -1,59 +1,244 @@
-/*
-  ==============================================================================
-
-    WaveformDisplay.cpp
-    Created: 18 Nov 2024 12:08:29pm
-    Author:  Leif Rehtanz
-
-  ==============================================================================
-*/
-
-#include "WaveformDisplay.h"
-
-WaveformDisplay::WaveformDisplay(int sourceSamplesPerWaveformSample,
-                                                   juce::AudioFormatManager& formatManager,
-                                                   juce::AudioThumbnailCache& cache)
-    : waveform(sourceSamplesPerWaveformSample, formatManager, cache)
-{
-    waveform.addChangeListener(this);
-}
-
-void WaveformDisplay::setFile(const juce::File& file)
-{
-    waveform.setSource(new juce::FileInputSource(file));
-}
-
-void WaveformDisplay::paint(juce::Graphics& g)
-{
-    if (waveform.getNumChannels() == 0)
-        paintIfNoFileLoaded(g);
-    else
-        paintIfFileLoaded(g);
-}
-
-void WaveformDisplay::paintIfNoFileLoaded(juce::Graphics& g)
-{
-    g.fillAll(juce::Colours::white);
-    g.setColour(juce::Colours::darkgrey);
-    g.drawFittedText("No File Loaded", getLocalBounds(), juce::Justification::centred, 1);
-}
-
-void WaveformDisplay::paintIfFileLoaded(juce::Graphics& g)
-{
-    g.fillAll(juce::Colours::white);
-    g.setColour(juce::Colours::blue);
-    waveform.drawChannels(g, getLocalBounds(), 0.0, waveform.getTotalLength(), 1.0f);
-}
-
-void WaveformDisplay::changeListenerCallback(juce::ChangeBroadcaster* source)
-{
-    if (source == &waveform)
-        waveformChanged();
-}
-
-void WaveformDisplay::waveformChanged()
-{
-    repaint();
-}
-
-
+/*
+  ==============================================================================
+
+    WaveformDisplay.cpp
+    Created: 18 Nov 2024 12:08:29pm
+    Author:  Leif Rehtanz
+
+  ==============================================================================
+*/
+
+#include "WaveformDisplay.h"
+
+WaveformDisplay::WaveformDisplay(int sourceSamplesPerWaveformSample,
+                                                   juce::AudioFormatManager& formatManager,
+                                                   juce::AudioThumbnailCache& cache)
+    : waveform(sourceSamplesPerWaveformSample, formatManager, cache)
+{
+    // The pyramid's top level is the thumbnail, so they must meet
+    jassert(sourceSamplesPerWaveformSample == WaveformPyramid::thumbnailSamplesPerPoint);
+
+    setOpaque(true);
+    waveform.addChangeListener(this);
+    pyramid.addChangeListener(this);
+}
+
+void WaveformDisplay::setFile(const MappedAudioFile& audioFile)
+{
+    // Both scan through the shared mapping. Hashed by content, so the
+    // persistent cache finds thumbnails from earlier sessions.
+    waveform.setReader(audioFile.createReader().release(),
+                       PersistentThumbnailCache::getContentHash(audioFile.getFile()));
+    pyramid.setFile(audioFile);
+
+    const auto sampleRate = pyramid.getSampleRate();
+    setVisibleRange({ 0.0, sampleRate > 0.0 ? (double) pyramid.getLengthInSamples() / sampleRate : 0.0 });
+}
+
+void WaveformDisplay::setVisibleRange(juce::Range<double> newRange)
+{
+    const auto sampleRate = pyramid.getSampleRate();
+    const auto totalLength = sampleRate > 0.0 ? (double) pyramid.getLengthInSamples() / sampleRate : 0.0;
+
+    // No closer than a few dozen samples across the whole width
+    const auto minLength = sampleRate > 0.0 ? juce::jmin(totalLength, 64.0 / sampleRate) : 0.0;
+    const auto length = juce::jlimit(minLength, totalLength, newRange.getLength());
+    const auto start = juce::jlimit(0.0, totalLength - length, newRange.getStart());
+
+    newRange = { start, start + length };
+
+    if (newRange == visibleRange)
+        return;
+
+    visibleRange = newRange;
+    waveformImageIsValid = false;
+    repaint();
+
+    if (visibleRangeChanged)
+        visibleRangeChanged(visibleRange);
+}
+
+void WaveformDisplay::setSibilantRegions(std::shared_ptr<const SibilantRegionIndex> newRegions)
+{
+    sibilantRegions = std::move(newRegions);
+    waveformChanged();
+}
+
+void WaveformDisplay::zoom(double factor, float anchorX)
+{
+    // Keep the time under the anchor where it is
+    const auto anchorProportion = juce::jlimit(0.0, 1.0, (double) anchorX / juce::jmax(1, getWidth()));
+    const auto anchorTime = visibleRange.getStart() + anchorProportion * visibleRange.getLength();
+    const auto newLength = visibleRange.getLength() * factor;
+
+    setVisibleRange({ anchorTime - anchorProportion * newLength, anchorTime + (1.0 - anchorProportion) * newLength });
+}
+
+void WaveformDisplay::mouseWheelMove(const juce::MouseEvent& event, const juce::MouseWheelDetails& wheel)
+{
+    if (event.mods.isCommandDown())
+    {
+        zoom(std::pow(2.0, -wheel.deltaY * 4.0), event.position.x);
+        return;
+    }
+
+    // Horizontal wheels and trackpads scroll sideways; a plain wheel does too
+    const auto delta = wheel.deltaX != 0.0f ? wheel.deltaX : wheel.deltaY;
+    setVisibleRange(visibleRange - delta * visibleRange.getLength());
+}
+
+void WaveformDisplay::mouseMagnify(const juce::MouseEvent& event, float scaleFactor)
+{
+    if (scaleFactor > 0.0f)
+        zoom(1.0 / scaleFactor, event.position.x);
+}
+
+void WaveformDisplay::paint(juce::Graphics& g)
+{
+    if (waveform.getNumChannels() == 0)
+        paintIfNoFileLoaded(g);
+    else
+        paintIfFileLoaded(g);
+}
+
+void WaveformDisplay::paintIfNoFileLoaded(juce::Graphics& g)
+{
+    g.fillAll(juce::Colours::white);
+    g.setColour(juce::Colours::darkgrey);
+    g.drawFittedText("No File Loaded", getLocalBounds(), juce::Justification::centred, 1);
+}
+
+void WaveformDisplay::paintIfFileLoaded(juce::Graphics& g)
+{
+    const auto scale = g.getInternalContext().getPhysicalPixelScaleFactor();
+
+    if (! waveformImageIsValid
+         || waveformImage.getWidth() != juce::roundToInt((float) getWidth() * scale)
+         || waveformImage.getHeight() != juce::roundToInt((float) getHeight() * scale))
+        renderWaveformImage(scale);
+
+    g.drawImage(waveformImage, getLocalBounds().toFloat());
+}
+
+void WaveformDisplay::renderWaveformImage(float scale)
+{
+    const int width = juce::jmax(1, juce::roundToInt((float) getWidth() * scale));
+    const int height = juce::jmax(1, juce::roundToInt((float) getHeight() * scale));
+
+    if (waveformImage.getWidth() != width || waveformImage.getHeight() != height)
+        waveformImage = juce::Image(juce::Image::RGB, width, height, false);
+
+    juce::Graphics imageGraphics(waveformImage);
+
+    imageGraphics.fillAll(juce::Colours::white);
+    drawSibilantRegions(imageGraphics, width, height);
+    imageGraphics.setColour(juce::Colours::blue);
+
+    const auto samplesPerPixel = visibleRange.getLength() * pyramid.getSampleRate() / width;
+
+    // Zoomed out the thumbnail has enough points per pixel; below that the
+    // pyramid's finer levels take over
+    if (pyramid.getNumChannels() == 0 || samplesPerPixel >= WaveformPyramid::thumbnailSamplesPerPoint)
+    {
+        imageGraphics.addTransform(juce::AffineTransform::scale(scale));
+        waveform.drawChannels(imageGraphics, getLocalBounds(), visibleRange.getStart(), visibleRange.getEnd(), 1.0f);
+    }
+    else
+    {
+        drawFromPyramid(imageGraphics, width, height, samplesPerPixel);
+    }
+
+    waveformImageIsValid = true;
+}
+
+void WaveformDisplay::drawFromPyramid(juce::Graphics& g, int width, int height, double samplesPerPixel)
+{
+    const int level = WaveformPyramid::getLevelFor(samplesPerPixel);
+    const int numChannels = pyramid.getNumChannels();
+    const auto startSample = visibleRange.getStart() * pyramid.getSampleRate();
+    const auto laneHeight = (float) height / (float) numChannels;
+
+    columnMins.resize((size_t) width);
+    columnMaxs.resize((size_t) width);
+
+    for (int channel = 0; channel < numChannels; ++channel)
+    {
+        // Columns whose tiles are still loading stay empty until the
+        // pyramid's change message brings them in
+        std::fill(columnMins.begin(), columnMins.end(), 1.0f);
+        std::fill(columnMaxs.begin(), columnMaxs.end(), -1.0f);
+        pyramid.getColumns(level, channel, startSample, samplesPerPixel, width, columnMins.data(), columnMaxs.data());
+
+        const auto centre = laneHeight * ((float) channel + 0.5f);
+        const auto halfHeight = laneHeight * 0.5f;
+
+        for (int x = 0; x < width; ++x)
+        {
+            auto low = columnMins[(size_t) x];
+            auto high = columnMaxs[(size_t) x];
+
+            if (low > high)
+                continue;
+
+            // Overlap the previous column so single samples join into a trace
+            if (x > 0 && columnMins[(size_t) x - 1] <= columnMaxs[(size_t) x - 1])
+            {
+                low = juce::jmin(low, columnMaxs[(size_t) x - 1]);
+                high = juce::jmax(high, columnMins[(size_t) x - 1]);
+            }
+
+            const auto top = centre - juce::jlimit(-1.0f, 1.0f, high) * halfHeight;
+            const auto bottom = centre - juce::jlimit(-1.0f, 1.0f, low) * halfHeight;
+            g.fillRect((float) x, top, 1.0f, juce::jmax(1.0f, bottom - top));
+        }
+    }
+}
+
+void WaveformDisplay::drawSibilantRegions(juce::Graphics& g, int width, int height)
+{
+    const auto sampleRate = pyramid.getSampleRate();
+
+    if (sibilantRegions == nullptr || sampleRate <= 0.0 || visibleRange.isEmpty())
+        return;
+
+    const auto startSample = visibleRange.getStart() * sampleRate;
+    const auto pixelsPerSample = width / (visibleRange.getLength() * sampleRate);
+    const auto regions = sibilantRegions->getRegionsIn((juce::int64) std::floor(startSample),
+                                                       (juce::int64) std::ceil(visibleRange.getEnd() * sampleRate));
+
+    g.setColour(juce::Colours::orange.withAlpha(0.3f));
+
+    // Zoomed out, many regions share a pixel; each pixel is only filled once
+    float filledUpTo = -1.0f;
+
+    for (auto region = regions.first; region != regions.second; ++region)
+    {
+        const auto left = juce::jmax(filledUpTo, (float) ((region->startSample - startSample) * pixelsPerSample));
+        const auto right = juce::jmax(left + 1.0f, (float) ((region->endSample - startSample) * pixelsPerSample));
+
+        if (right <= filledUpTo)
+            continue;
+
+        g.fillRect(left, 0.0f, right - left, (float) height);
+        filledUpTo = right;
+    }
+}
+
+void WaveformDisplay::resized()
+{
+    waveformImageIsValid = false;
+}
+
+void WaveformDisplay::changeListenerCallback(juce::ChangeBroadcaster* source)
+{
+    if (source == &waveform || source == &pyramid)
+        waveformChanged();
+}
+
+void WaveformDisplay::waveformChanged()
+{
+    waveformImageIsValid = false;
+    repaint();
+}
+
+
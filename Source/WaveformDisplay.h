@@ -1,35 +1,72 @@
-/*
-  ==============================================================================
-
-    WaveformDisplay.h
-    Created: 18 Nov 2024 12:08:29pm
-    Author:  Leif Rehtanz
-
-  ==============================================================================
-*/
-
-#pragma once
-
-#include <JuceHeader.h>
-
-class WaveformDisplay : public juce::Component,
-                        private juce::ChangeListener
-{
-    public:
-    WaveformDisplay(int sourceSamplesPerWaveformSample,
-                    juce::AudioFormatManager& formatManager,
-                    juce::AudioThumbnailCache& cache);
-    
-    void setFile(const juce::File& file);
-    void paint(juce::Graphics& g) override;
-    
-    private:
-    void paintIfNoFileLoaded(juce::Graphics& g);
-    void paintIfFileLoaded(juce::Graphics& g);
-    void changeListenerCallback(juce::ChangeBroadcaster* source) override;
-    void waveformChanged();
-    
-    juce::AudioThumbnail waveform;
-    
-    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(WaveformDisplay)
-};
+/*
+  ==============================================================================
+
+    WaveformDisplay.h
+    Created: 18 Nov 2024 12:08:29pm
+    Author:  Leif Rehtanz
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <functional>
+#include "MappedAudioFile.h"
+#include "PersistentThumbnailCache.h"
+#include "SibilantRegion.h"
+#include "WaveformPyramid.h"
+
+class WaveformDisplay : public juce::Component,
+                        private juce::ChangeListener
+{
+    public:
+    WaveformDisplay(int sourceSamplesPerWaveformSample,
+                    juce::AudioFormatManager& formatManager,
+                    juce::AudioThumbnailCache& cache);
+    
+    void setFile(const MappedAudioFile& audioFile);
+    void paint(juce::Graphics& g) override;
+    void resized() override;
+
+    // Wheel scrolls, cmd/ctrl + wheel and pinch zoom around the mouse
+    void mouseWheelMove(const juce::MouseEvent& event, const juce::MouseWheelDetails& wheel) override;
+    void mouseMagnify(const juce::MouseEvent& event, float scaleFactor) override;
+
+    // Visible part of the file, in seconds
+    juce::Range<double> getVisibleRange() const noexcept  { return visibleRange; }
+    void setVisibleRange(juce::Range<double> newRange);
+
+    std::function<void(juce::Range<double>)> visibleRangeChanged; // Callback for zoom and scroll
+
+    // Shaded behind the waveform; nullptr clears them
+    void setSibilantRegions(std::shared_ptr<const SibilantRegionIndex> newRegions);
+    
+    private:
+    void paintIfNoFileLoaded(juce::Graphics& g);
+    void paintIfFileLoaded(juce::Graphics& g);
+    void renderWaveformImage(float scale);
+    void drawFromPyramid(juce::Graphics& g, int width, int height, double samplesPerPixel);
+    void drawSibilantRegions(juce::Graphics& g, int width, int height);
+    void zoom(double factor, float anchorX);
+    void changeListenerCallback(juce::ChangeBroadcaster* source) override;
+    void waveformChanged();
+    
+    juce::AudioThumbnail waveform;
+
+    // Finer levels for when the view is zoomed in past the thumbnail
+    WaveformPyramid pyramid;
+    juce::Range<double> visibleRange;
+    std::vector<float> columnMins, columnMaxs;
+    std::shared_ptr<const SibilantRegionIndex> sibilantRegions;
+
+    // The waveform at physical pixel resolution. Overlays repaint small
+    // strips on top of this component many times a second, so those repaints
+    // blit from here instead of going back to the thumbnail; the image is
+    // only re-rendered after a resize, a zoom or scroll, or when the
+    // thumbnail or pyramid has new data.
+    juce::Image waveformImage;
+    bool waveformImageIsValid = false;
+    
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(WaveformDisplay)
+};
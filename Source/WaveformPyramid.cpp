@@ -0,0 +1,257 @@
+/*
+  ==============================================================================
+
+    WaveformPyramid.cpp
+    Created: 17 Oct 2026 9:14:37pm
+    Author:  Leif Rehtanz
+
+  ==============================================================================
+*/
+
+#include "WaveformPyramid.h"
+
+WaveformPyramid::WaveformPyramid()
+    : juce::Thread("Waveform tile loader")
+{
+    startThread(juce::Thread::Priority::low);
+}
+
+WaveformPyramid::~WaveformPyramid()
+{
+    signalThreadShouldExit();
+    notify();
+    stopThread(2000);
+}
+
+void WaveformPyramid::setFile(const MappedAudioFile& audioFile)
+{
+    {
+        const juce::ScopedLock sl(readerLock);
+        reader = audioFile.createReader();
+
+        numChannels = reader != nullptr ? (int) reader->numChannels : 0;
+        sampleRate = reader != nullptr ? reader->sampleRate : 0.0;
+        lengthInSamples = reader != nullptr ? reader->lengthInSamples : 0;
+    }
+
+    const juce::ScopedLock sl(tileLock);
+    tiles.clear();
+    leastRecentlyUsed.clear();
+    requestQueue.clear();
+    pendingRequests.clear();
+    ++fileGeneration;
+}
+
+int WaveformPyramid::getSamplesPerPoint(int level) noexcept
+{
+    int samplesPerPoint = 1;
+
+    for (int i = 0; i < level; ++i)
+        samplesPerPoint *= levelFactor;
+
+    return samplesPerPoint;
+}
+
+int WaveformPyramid::getLevelFor(double samplesPerPixel) noexcept
+{
+    int level = 0;
+
+    while (level + 1 < numLevels && getSamplesPerPoint(level + 1) <= samplesPerPixel)
+        ++level;
+
+    return level;
+}
+
+bool WaveformPyramid::getColumns(int level, int channel, double startSample, double samplesPerColumn,
+                                 int numColumns, float* mins, float* maxs)
+{
+    jassert(juce::isPositiveAndBelow(level, numLevels) && juce::isPositiveAndBelow(channel, numChannels));
+
+    const auto samplesPerPoint = (double) getSamplesPerPoint(level);
+    const auto numPointsInFile = (juce::int64) std::ceil((double) lengthInSamples / samplesPerPoint);
+    bool complete = true;
+
+    const juce::ScopedLock sl(tileLock);
+
+    // Neighbouring columns almost always share a tile, so keep the last one at hand
+    TileKey currentKey { level, -1 };
+    std::shared_ptr<const Tile> currentTile;
+
+    for (int column = 0; column < numColumns; ++column)
+    {
+        const auto columnStart = startSample + column * samplesPerColumn;
+        const auto columnEnd = columnStart + samplesPerColumn;
+
+        if (columnEnd <= 0.0 || columnStart >= (double) lengthInSamples)
+            continue;
+
+        const auto firstPoint = juce::jmax((juce::int64) 0, (juce::int64) std::floor(columnStart / samplesPerPoint));
+        const auto lastPoint = juce::jlimit(firstPoint, numPointsInFile - 1, (juce::int64) std::ceil(columnEnd / samplesPerPoint) - 1);
+
+        float minValue = std::numeric_limits<float>::max();
+        float maxValue = std::numeric_limits<float>::lowest();
+        bool columnComplete = true;
+
+        for (auto point = firstPoint; point <= lastPoint; ++point)
+        {
+            const auto tileIndex = point / pointsPerTile;
+
+            if (tileIndex != currentKey.second)
+            {
+                currentKey.second = tileIndex;
+                currentTile = findTile(currentKey);
+
+                if (currentTile == nullptr)
+                    requestTile(currentKey);
+            }
+
+            if (currentTile == nullptr)
+            {
+                columnComplete = false;
+                continue;
+            }
+
+            const auto index = (int) (point % pointsPerTile);
+
+            if (index < currentTile->numPoints)
+            {
+                const auto* channelData = currentTile->data.data() + (size_t) channel * 2 * pointsPerTile;
+                minValue = juce::jmin(minValue, channelData[index]);
+                maxValue = juce::jmax(maxValue, channelData[pointsPerTile + index]);
+            }
+        }
+
+        if (columnComplete && minValue <= maxValue)
+        {
+            mins[column] = minValue;
+            maxs[column] = maxValue;
+        }
+        else
+        {
+            complete = false;
+        }
+    }
+
+    return complete;
+}
+
+std::shared_ptr<const WaveformPyramid::Tile> WaveformPyramid::findTile(const TileKey& key)
+{
+    auto found = tiles.find(key);
+
+    if (found == tiles.end())
+        return {};
+
+    leastRecentlyUsed.splice(leastRecentlyUsed.begin(), leastRecentlyUsed, found->second.second);
+    return found->second.first;
+}
+
+void WaveformPyramid::requestTile(const TileKey& key)
+{
+    if (! pendingRequests.insert(key).second)
+        return;
+
+    // Newest first: when scrolling, the tiles on screen now matter most
+    requestQueue.push_front(key);
+    notify();
+}
+
+void WaveformPyramid::run()
+{
+    while (! threadShouldExit())
+    {
+        TileKey key;
+        int generation = 0;
+        bool hasRequest = false;
+
+        {
+            const juce::ScopedLock sl(tileLock);
+
+            if (! requestQueue.empty())
+            {
+                key = requestQueue.front();
+                requestQueue.pop_front();
+                generation = fileGeneration;
+                hasRequest = true;
+            }
+        }
+
+        if (hasRequest)
+            loadTile(key, generation);
+        else
+            wait(-1);
+    }
+}
+
+void WaveformPyramid::loadTile(const TileKey& key, int generation)
+{
+    // Whatever happens below, the tile is no longer pending, so one that failed
+    // to load is asked for again instead of staying blank. A newer file's
+    // requests are left alone.
+    const juce::ScopeGuard clearRequest { [this, key, generation]
+    {
+        const juce::ScopedLock sl(tileLock);
+
+        if (generation == fileGeneration)
+            pendingRequests.erase(key);
+    } };
+
+    auto tile = std::make_shared<Tile>();
+
+    {
+        const juce::ScopedLock sl(readerLock);
+
+        if (reader == nullptr)
+            return;
+
+        const int samplesPerPoint = getSamplesPerPoint(key.first);
+        const auto firstSample = key.second * pointsPerTile * samplesPerPoint;
+        const int numSamples = (int) juce::jmin((juce::int64) pointsPerTile * samplesPerPoint, reader->lengthInSamples - firstSample);
+        const int tileChannels = (int) reader->numChannels;
+
+        if (numSamples <= 0)
+            return;
+
+        readBuffer.setSize(tileChannels, numSamples, false, false, true);
+
+        if (! reader->read(&readBuffer, 0, numSamples, firstSample, true, true))
+            return;
+
+        tile->numPoints = (numSamples + samplesPerPoint - 1) / samplesPerPoint;
+        tile->data.resize((size_t) tileChannels * 2 * pointsPerTile);
+
+        for (int channel = 0; channel < tileChannels; ++channel)
+        {
+            const auto* source = readBuffer.getReadPointer(channel);
+            auto* mins = tile->data.data() + (size_t) channel * 2 * pointsPerTile;
+            auto* maxs = mins + pointsPerTile;
+
+            for (int point = 0; point < tile->numPoints; ++point)
+            {
+                const int offset = point * samplesPerPoint;
+                const auto range = juce::FloatVectorOperations::findMinAndMax(source + offset, juce::jmin(samplesPerPoint, numSamples - offset));
+                mins[point] = range.getStart();
+                maxs[point] = range.getEnd();
+            }
+        }
+    }
+
+    {
+        const juce::ScopedLock sl(tileLock);
+
+        // A file loaded while this tile was being read makes it useless
+        if (generation != fileGeneration)
+            return;
+
+        leastRecentlyUsed.push_front(key);
+        tiles[key] = { std::move(tile), leastRecentlyUsed.begin() };
+
+        while ((int) tiles.size() > maxCachedTiles)
+        {
+            tiles.erase(leastRecentlyUsed.back());
+            leastRecentlyUsed.pop_back();
+        }
+    }
+
+    sendChangeMessage();
+}
@@ -0,0 +1,94 @@
+/*
+  ==============================================================================
+
+    WaveformPyramid.h
+    Created: 17 Oct 2026 9:14:37pm
+    Author:  Leif Rehtanz
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <deque>
+#include <list>
+#include <map>
+#include <set>
+#include "MappedAudioFile.h"
+
+// Min/max overview of an audio file below the AudioThumbnail's resolution:
+// levels of 64, 8 and 1 source samples per point, each factor of 8 finer
+// than the one above, with the 512-sample thumbnail as the top level. Levels
+// are split into tiles of pointsPerTile points that are only read from disk
+// when a view asks for them, on a background thread, and kept in a bounded
+// LRU cache, so zooming into a multi-GB file only ever touches the tiles on
+// screen. A change message goes out whenever a tile arrives.
+class WaveformPyramid : public juce::ChangeBroadcaster,
+                        private juce::Thread
+{
+public:
+    static constexpr int thumbnailSamplesPerPoint = 512;
+    static constexpr int levelFactor = 8;
+    static constexpr int numLevels = 3;        // 1, 8 and 64 samples per point
+    static constexpr int pointsPerTile = 4096;
+    static constexpr int maxCachedTiles = 256;
+
+    WaveformPyramid();
+    ~WaveformPyramid() override;
+
+    // Drops every tile and starts serving the new file; message thread
+    void setFile(const MappedAudioFile& audioFile);
+
+    int getNumChannels() const noexcept           { return numChannels; }
+    double getSampleRate() const noexcept         { return sampleRate; }
+    juce::int64 getLengthInSamples() const noexcept { return lengthInSamples; }
+
+    static int getSamplesPerPoint(int level) noexcept;
+
+    // Coarsest level with at most one point per pixel, so a column never
+    // combines more than levelFactor points. Only meaningful below
+    // thumbnailSamplesPerPoint.
+    static int getLevelFor(double samplesPerPixel) noexcept;
+
+    // Fills mins/maxs with one column per numColumns, the first starting at
+    // startSample and each covering samplesPerColumn samples (which may be
+    // less than one). Columns whose tiles aren't loaded yet are left untouched
+    // and their tiles are queued; returns false if there were any.
+    bool getColumns(int level, int channel, double startSample, double samplesPerColumn,
+                    int numColumns, float* mins, float* maxs);
+
+private:
+    struct Tile
+    {
+        // Per channel: pointsPerTile mins followed by pointsPerTile maxs
+        std::vector<float> data;
+        int numPoints = 0;
+    };
+
+    using TileKey = std::pair<int, juce::int64>; // Level, tile index
+
+    void run() override;
+    void loadTile(const TileKey& key, int generation);
+    std::shared_ptr<const Tile> findTile(const TileKey& key);
+    void requestTile(const TileKey& key);
+
+    // Only replaced by setFile(), which the loader thread is locked out of
+    juce::CriticalSection readerLock;
+    std::unique_ptr<juce::AudioFormatReader> reader;
+    juce::AudioBuffer<float> readBuffer;
+
+    int numChannels = 0;
+    double sampleRate = 0.0;
+    juce::int64 lengthInSamples = 0;
+
+    // Tiles and the queue of requested ones; guards everything below
+    juce::CriticalSection tileLock;
+    std::map<TileKey, std::pair<std::shared_ptr<const Tile>, std::list<TileKey>::iterator>> tiles;
+    std::list<TileKey> leastRecentlyUsed; // Most recent at the front
+    std::deque<TileKey> requestQueue;
+    std::set<TileKey> pendingRequests;
+    int fileGeneration = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(WaveformPyramid)
+};
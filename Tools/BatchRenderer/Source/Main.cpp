@@ -0,0 +1,438 @@
+/*
+  ==============================================================================
+
+    Main.cpp
+    Created: 17 Oct 2026 3:41:27pm
+    Author:  Leif Rehtanz
+
+    Headless batch renderer: de-esses audio files offline, without a display
+    or an audio device, for use on render nodes.
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include <iostream>
+#include <map>
+#include <set>
+#include "../../../Source/OfflineRenderer.h"
+#include "../../../Source/ParameterSearch.h"
+#include "WorkStealingScheduler.h"
+
+namespace
+{
+    void printUsage()
+    {
+        std::cout << "Usage: DeEssDoctorBatch [options] --output=<file or folder> <input files...>\n"
+                     "       DeEssDoctorBatch [options] --output=<folder> --input-folder=<folder>\n"
+                     "       DeEssDoctorBatch [search options] --suggest <input files...>\n"
+                     "\n"
+                     "  --output=<path>        Output WAV, or a folder when rendering several inputs\n"
+                     "  --input-folder=<path>  Render every audio file below this folder, keeping\n"
+                     "                         the sub-folder layout in the output folder\n"
+                     "  --workers=<n>          Files rendered in parallel (default: one per CPU core,\n"
+                     "                         divided by --threads-per-file)\n"
+                     "  --threads-per-file=<n> Split each file into chunks rendered on n threads; the\n"
+                     "                         output is identical to a single-threaded render (default 1)\n"
+                     "  --chunk-seconds=<s>    Chunk length for --threads-per-file (default 30)\n"
+                     "  --threshold=<dB>       Sibilance detection threshold (default -20)\n"
+                     "  --mix=<dB>             Gain applied to detected sibilants (default 0)\n"
+                     "  --frequency=<Hz>       Crossover frequency of the sibilant band (default 6500)\n"
+                     "  --hysteresis=<n>       Hold time in samples after a detection (default 50)\n"
+                     "  --block-size=<n>       Samples processed per block (default 8192)\n"
+                     "  --detection=<mode>     sample: gate every sample (default); peak or rms: decide\n"
+                     "                         once per control interval and glide the gain\n"
+                     "  --control-interval=<n> Samples per decision for peak and rms (default 16)\n"
+                     "  --help                 Show this message\n"
+                     "\n"
+                     "Parameter search:\n"
+                     "  --suggest              Rank threshold, frequency and hysteresis settings for each\n"
+                     "                         input instead of rendering\n"
+                     "  --auto-settings        Render each input with the best settings found for it\n"
+                     "  --top=<n>              Settings listed per file by --suggest (default 10)\n"
+                     "  --search-thresholds=<dB,dB,...>   Thresholds to try\n"
+                     "  --search-frequencies=<Hz,Hz,...>  Crossover frequencies to try\n"
+                     "  --search-hysteresis=<n,n,...>     Hysteresis lengths to try\n"
+                     "  --collateral-weight=<w> How much energy taken outside the esses costs against\n"
+                     "                         energy taken out of them (default 4)\n"
+                     "  The search keeps --mix fixed, at -12 dB unless given.\n";
+    }
+
+    float getFloatOption(const juce::ArgumentList& args, juce::StringRef option, float defaultValue)
+    {
+        return args.containsOption(option) ? args.getValueForOption(option).getFloatValue() : defaultValue;
+    }
+
+    // Comma-separated values, e.g. --search-thresholds=-40,-30,-20
+    template <typename ValueType>
+    juce::Array<ValueType> getListOption(const juce::ArgumentList& args, juce::StringRef option,
+                                         const juce::Array<ValueType>& defaultValues)
+    {
+        if (! args.containsOption(option))
+            return defaultValues;
+
+        juce::Array<ValueType> values;
+
+        for (auto& token : juce::StringArray::fromTokens(args.getValueForOption(option), ",", {}))
+            if (token.trim().isNotEmpty())
+                values.add((ValueType) token.trim().getDoubleValue());
+
+        return values;
+    }
+
+    juce::String describe(const ParameterSearch::Candidate& candidate)
+    {
+        return "threshold " + juce::String(candidate.threshold, 1) + " dB, frequency "
+             + juce::String(juce::roundToInt(candidate.frequency)) + " Hz, hysteresis "
+             + juce::String(juce::roundToInt(candidate.hysteresis));
+    }
+
+    // --suggest: search each file with every core and print the best settings
+    int suggestSettings(const std::vector<juce::File>& inputFiles, const ParameterSearch::Settings& searchSettings, int numToShow)
+    {
+        juce::AudioFormatManager formatManager;
+        formatManager.registerBasicFormats();
+        ParameterSearch search;
+        int numFailed = 0;
+
+        for (const auto& inputFile : inputFiles)
+        {
+            std::unique_ptr<juce::AudioFormatReader> reader(formatManager.createReaderFor(inputFile));
+            const auto result = reader != nullptr ? search.search(*reader, searchSettings) : ParameterSearch::Result();
+
+            if (reader == nullptr || ! result.wasSuccessful())
+            {
+                std::cerr << inputFile.getFullPathName() << ": "
+                          << (reader == nullptr ? juce::String("Could not open the input") : result.errorMessage) << "\n";
+                ++numFailed;
+                continue;
+            }
+
+            std::cout << inputFile.getFileName() << ": " << (int) result.candidates.size() << " settings in "
+                      << juce::String(result.processingSeconds, 2) << " s, "
+                      << juce::String(result.sibilantFraction * 100.0, 1) << "% of frames sibilant\n";
+
+            for (int i = 0; i < juce::jmin(numToShow, (int) result.candidates.size()); ++i)
+            {
+                const auto& candidate = result.candidates[(size_t) i];
+                std::cout << "  " << juce::String(i + 1).paddedLeft(' ', 3) << ". " << describe(candidate)
+                          << ": score " << juce::String(candidate.score, 2)
+                          << " (esses -" << juce::String(candidate.sibilantReductionDb, 2)
+                          << " dB, elsewhere -" << juce::String(candidate.collateralChangeDb, 2)
+                          << " dB, gated " << juce::String(candidate.gatedFraction * 100.0, 1) << "%)\n";
+            }
+        }
+
+        return numFailed == 0 ? 0 : 1;
+    }
+
+    struct RenderJob
+    {
+        juce::File inputFile;
+        juce::File outputFile;
+        juce::int64 inputSize = 0;
+        int workerIndex = -1;
+        OfflineRenderer::Result result;
+        juce::String chosenSettings;   // --auto-settings only
+    };
+
+    // Case-insensitive, as on the file systems most renders end up on
+    juce::String getPathKey(const juce::File& file)
+    {
+        return file.getFullPathName().toLowerCase();
+    }
+
+    // Inputs that differ only in extension (take.wav, take.flac), or same-named
+    // inputs from different folders, would render into one file with two
+    // workers writing it at once. Each colliding output gets its input's
+    // format added to the name (take-wav.wav, take-flac.wav). Returns the
+    // first output that still collides, or File() if none do.
+    juce::File disambiguateOutputFiles(std::vector<RenderJob>& jobs)
+    {
+        std::map<juce::String, int> numJobsPerOutput;
+
+        for (const auto& job : jobs)
+            ++numJobsPerOutput[getPathKey(job.outputFile)];
+
+        for (auto& job : jobs)
+        {
+            if (numJobsPerOutput[getPathKey(job.outputFile)] < 2)
+                continue;
+
+            const auto format = job.inputFile.getFileExtension().trimCharactersAtStart(".").toLowerCase();
+            job.outputFile = job.outputFile.getSiblingFile(job.outputFile.getFileNameWithoutExtension()
+                                                           + "-" + format + ".wav");
+        }
+
+        std::set<juce::String> outputs;
+
+        for (const auto& job : jobs)
+            if (! outputs.insert(getPathKey(job.outputFile)).second)
+                return job.outputFile;
+
+        return {};
+    }
+
+    // Every worker has its own format manager and renderer, so nothing is shared while rendering
+    struct Worker
+    {
+        Worker()  { formatManager.registerBasicFormats(); }
+
+        juce::AudioFormatManager formatManager;
+        OfflineRenderer renderer;
+        ParameterSearch search;
+        int numFiles = 0;
+        double busySeconds = 0.0;
+    };
+}
+
+int main(int argc, char* argv[])
+{
+    juce::ArgumentList args(argc, argv);
+
+    if (args.containsOption("--help|-h"))
+    {
+        printUsage();
+        return 0;
+    }
+
+    const auto outputPath = args.getValueForOption("--output");
+    const auto inputFolderPath = args.getValueForOption("--input-folder");
+
+    ParameterSearch::Settings searchSettings;
+    searchSettings.thresholds = getListOption(args, "--search-thresholds", searchSettings.thresholds);
+    searchSettings.frequencies = getListOption(args, "--search-frequencies", searchSettings.frequencies);
+    searchSettings.hysteresisValues = getListOption(args, "--search-hysteresis", searchSettings.hysteresisValues);
+    searchSettings.mixLevel = getFloatOption(args, "--mix", searchSettings.mixLevel);
+    searchSettings.collateralWeight = getFloatOption(args, "--collateral-weight", searchSettings.collateralWeight);
+
+    if (args.containsOption("--suggest"))
+    {
+        std::vector<juce::File> inputFiles;
+
+        for (auto& arg : args.arguments)
+            if (! arg.isOption())
+                inputFiles.push_back(arg.resolveAsFile());
+
+        if (inputFiles.empty())
+        {
+            printUsage();
+            return 1;
+        }
+
+        return suggestSettings(inputFiles, searchSettings, (int) getFloatOption(args, "--top", 10.0f));
+    }
+
+    const bool autoSettings = args.containsOption("--auto-settings");
+
+    if (outputPath.isEmpty())
+    {
+        printUsage();
+        return 1;
+    }
+
+    const auto output = juce::File::getCurrentWorkingDirectory().getChildFile(outputPath);
+    std::vector<RenderJob> jobs;
+
+    for (auto& arg : args.arguments)
+        if (! arg.isOption())
+            jobs.push_back({ arg.resolveAsFile(), {} });
+
+    juce::AudioFormatManager formatManager;
+    formatManager.registerBasicFormats();
+
+    const auto inputFolder = juce::File::getCurrentWorkingDirectory().getChildFile(inputFolderPath);
+
+    if (inputFolderPath.isNotEmpty())
+    {
+        if (! inputFolder.isDirectory())
+        {
+            std::cerr << "Input folder " << inputFolder.getFullPathName() << " does not exist\n";
+            return 1;
+        }
+
+        for (const auto& entry : juce::RangedDirectoryIterator(inputFolder, true, formatManager.getWildcardForAllFormats(),
+                                                                juce::File::findFiles))
+            jobs.push_back({ entry.getFile(), {} });
+    }
+
+    // An input given twice, say listed and also inside the input folder, is rendered once
+    std::set<juce::String> inputs;
+    jobs.erase(std::remove_if(jobs.begin(), jobs.end(),
+                              [&] (const RenderJob& job) { return ! inputs.insert(getPathKey(job.inputFile)).second; }),
+               jobs.end());
+
+    if (jobs.empty())
+    {
+        printUsage();
+        return 1;
+    }
+
+    OfflineRenderer::Settings settings;
+    settings.threshold  = getFloatOption(args, "--threshold", settings.threshold);
+    settings.mixLevel   = getFloatOption(args, "--mix", settings.mixLevel);
+    settings.frequency  = getFloatOption(args, "--frequency", settings.frequency);
+    settings.hysteresis = getFloatOption(args, "--hysteresis", settings.hysteresis);
+    settings.blockSize  = (int) getFloatOption(args, "--block-size", (float) settings.blockSize);
+    settings.numThreads = juce::jmax(1, (int) getFloatOption(args, "--threads-per-file", (float) settings.numThreads));
+    settings.chunkSeconds = getFloatOption(args, "--chunk-seconds", (float) settings.chunkSeconds);
+    settings.detection.controlInterval = (int) getFloatOption(args, "--control-interval",
+                                                              (float) settings.detection.controlInterval);
+
+    if (args.containsOption("--detection"))
+    {
+        const auto mode = args.getValueForOption("--detection");
+
+        if (mode == "peak")
+            settings.detection.mode = DeEssEngine::Detection::Mode::peak;
+        else if (mode == "rms")
+            settings.detection.mode = DeEssEngine::Detection::Mode::rms;
+        else if (mode != "sample")
+        {
+            std::cerr << "Unknown detection mode " << mode << "\n";
+            printUsage();
+            return 1;
+        }
+    }
+
+    // The search runs on the file's own threads, with the mix it renders with
+    searchSettings.numThreads = settings.numThreads;
+
+    if (autoSettings)
+        settings.mixLevel = searchSettings.mixLevel;
+
+    // Several inputs always go into a folder, named after each input
+    const bool outputIsFolder = jobs.size() > 1 || inputFolderPath.isNotEmpty() || output.isDirectory();
+
+    if (outputIsFolder && ! output.createDirectory())
+    {
+        std::cerr << "Could not create output folder " << output.getFullPathName() << "\n";
+        return 1;
+    }
+
+    for (auto& job : jobs)
+    {
+        job.inputSize = job.inputFile.getSize();
+
+        if (! outputIsFolder)
+            job.outputFile = output;
+        else if (inputFolderPath.isNotEmpty() && job.inputFile.isAChildOf(inputFolder))
+            job.outputFile = output.getChildFile(job.inputFile.getRelativePathFrom(inputFolder)).withFileExtension("wav");
+        else
+            job.outputFile = output.getChildFile(job.inputFile.getFileNameWithoutExtension() + ".wav");
+    }
+
+    const auto collidingOutput = disambiguateOutputFiles(jobs);
+
+    if (collidingOutput != juce::File())
+    {
+        std::cerr << "Several inputs would render to " << collidingOutput.getFullPathName()
+                  << "; rename them or render them in separate runs\n";
+        return 1;
+    }
+
+    // Largest files first, so the long renders start early and small ones fill in at the end
+    std::sort(jobs.begin(), jobs.end(), [] (const RenderJob& a, const RenderJob& b) { return a.inputSize > b.inputSize; });
+
+    // Each worker runs settings.numThreads threads of its own
+    const int defaultNumWorkers = juce::jmax(1, juce::SystemStats::getNumCpus() / settings.numThreads);
+    const int numWorkers = juce::jlimit(1, (int) jobs.size(),
+                                        (int) getFloatOption(args, "--workers", (float) defaultNumWorkers));
+
+    WorkStealingScheduler<int> scheduler(numWorkers);
+    std::vector<std::unique_ptr<Worker>> workers;
+
+    for (int i = 0; i < numWorkers; ++i)
+        workers.push_back(std::make_unique<Worker>());
+
+    for (int i = 0; i < (int) jobs.size(); ++i)
+        scheduler.addJob(i);
+
+    const auto startTicks = juce::Time::getHighResolutionTicks();
+
+    scheduler.run([&] (int workerIndex, int& jobIndex)
+    {
+        auto& job = jobs[(size_t) jobIndex];
+        auto& worker = *workers[(size_t) workerIndex];
+
+        job.outputFile.getParentDirectory().createDirectory();
+        job.workerIndex = workerIndex;
+
+        auto jobSettings = settings;
+
+        if (autoSettings)
+        {
+            std::unique_ptr<juce::AudioFormatReader> reader(worker.formatManager.createReaderFor(job.inputFile));
+            const auto searchResult = reader != nullptr ? worker.search.search(*reader, searchSettings)
+                                                        : ParameterSearch::Result();
+
+            if (reader == nullptr || ! searchResult.wasSuccessful() || searchResult.candidates.empty())
+            {
+                job.result.errorMessage = "Parameter search failed: "
+                                        + (reader == nullptr ? juce::String("could not open the input") : searchResult.errorMessage);
+                return;
+            }
+
+            const auto& best = searchResult.candidates.front();
+            jobSettings.threshold = best.threshold;
+            jobSettings.frequency = best.frequency;
+            jobSettings.hysteresis = best.hysteresis;
+            job.chosenSettings = describe(best);
+            worker.busySeconds += searchResult.processingSeconds;
+        }
+
+        job.result = worker.renderer.renderFile(worker.formatManager, job.inputFile, job.outputFile, jobSettings);
+
+        ++worker.numFiles;
+        worker.busySeconds += job.result.processingSeconds;
+    });
+
+    const double wallSeconds = juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - startTicks);
+
+    int numFailed = 0;
+    double totalAudioSeconds = 0.0;
+
+    for (auto& job : jobs)
+    {
+        if (! job.result.wasSuccessful())
+        {
+            std::cerr << job.inputFile.getFullPathName() << ": " << job.result.errorMessage << "\n";
+            ++numFailed;
+            continue;
+        }
+
+        totalAudioSeconds += job.result.getAudioSeconds();
+
+        std::cout << job.inputFile.getFileName() << " -> " << job.outputFile.getFullPathName()
+                  << ": " << juce::String(job.result.getAudioSeconds(), 1) << " s of audio in "
+                  << juce::String(job.result.processingSeconds, 3) << " s ("
+                  << juce::String(job.result.getSpeedFactor(), 1) << "x realtime, worker "
+                  << job.workerIndex;
+
+        if (job.result.numChunks > 0)
+            std::cout << ", " << job.result.numChunks << " chunks, "
+                      << job.result.numSamplesRerendered << " samples re-rendered at chunk starts";
+
+        std::cout << ")\n";
+
+        if (job.chosenSettings.isNotEmpty())
+            std::cout << "  with " << job.chosenSettings << "\n";
+    }
+
+    std::cout << "\nWorkers: " << numWorkers << ", steals: " << scheduler.getNumSteals() << "\n";
+
+    for (int i = 0; i < numWorkers; ++i)
+        std::cout << "  worker " << i << ": " << workers[(size_t) i]->numFiles << " files, busy "
+                  << juce::String(workers[(size_t) i]->busySeconds, 2) << " s of "
+                  << juce::String(wallSeconds, 2) << " s\n";
+
+    std::cout << "Total: " << (int) jobs.size() - numFailed << " files, "
+              << juce::String(totalAudioSeconds, 1) << " s of audio in "
+              << juce::String(wallSeconds, 3) << " s ("
+              << juce::String(wallSeconds > 0.0 ? totalAudioSeconds / wallSeconds : 0.0, 1) << "x realtime)\n";
+
+    if (numFailed > 0)
+        std::cout << numFailed << " files failed\n";
+
+    return numFailed == 0 ? 0 : 1;
+}
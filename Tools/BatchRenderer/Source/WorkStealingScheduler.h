@@ -0,0 +1,118 @@
+/*
+  ==============================================================================
+
+    WorkStealingScheduler.h
+    Created: 17 Oct 2026 5:02:48pm
+    Author:  Leif Rehtanz
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+// Runs a fixed set of jobs on a pool of worker threads. Every worker has its
+// own deque: it takes jobs from the front of its own deque and, once that is
+// empty, steals from the back of another worker's. Jobs are dealt out in the
+// order they were added, so adding the biggest jobs first means every worker
+// starts on a big one and the small ones fill in the gaps at the end.
+template <typename Job>
+class WorkStealingScheduler
+{
+public:
+    using JobFunction = std::function<void(int workerIndex, Job& job)>;
+
+    explicit WorkStealingScheduler(int numWorkersToUse)
+        : queues((size_t) juce::jmax(1, numWorkersToUse))
+    {
+    }
+
+    int getNumWorkers() const noexcept  { return (int) queues.size(); }
+
+    // Deals the job to the workers round-robin; call before run()
+    void addJob(Job job)
+    {
+        auto& queue = queues[(size_t) (numJobsAdded++ % (int) queues.size())];
+        const std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.jobs.push_back(std::move(job));
+    }
+
+    // Blocks until every job has been run. Worker 0 is the calling thread.
+    void run(const JobFunction& jobFunction)
+    {
+        std::vector<std::thread> threads;
+
+        for (int worker = 1; worker < getNumWorkers(); ++worker)
+            threads.emplace_back([this, worker, &jobFunction] { workerLoop(worker, jobFunction); });
+
+        workerLoop(0, jobFunction);
+
+        for (auto& thread : threads)
+            thread.join();
+    }
+
+    // Number of jobs that ran on a worker other than the one they were dealt to
+    int getNumSteals() const noexcept  { return numSteals.load(); }
+
+private:
+    struct Queue
+    {
+        std::mutex mutex;
+        std::deque<Job> jobs;
+    };
+
+    bool popOwn(int worker, Job& job)
+    {
+        auto& queue = queues[(size_t) worker];
+        const std::lock_guard<std::mutex> lock(queue.mutex);
+
+        if (queue.jobs.empty())
+            return false;
+
+        job = std::move(queue.jobs.front());
+        queue.jobs.pop_front();
+        return true;
+    }
+
+    bool steal(int thief, Job& job)
+    {
+        const int numWorkers = getNumWorkers();
+
+        for (int offset = 1; offset < numWorkers; ++offset)
+        {
+            auto& queue = queues[(size_t) ((thief + offset) % numWorkers)];
+            const std::lock_guard<std::mutex> lock(queue.mutex);
+
+            if (! queue.jobs.empty())
+            {
+                job = std::move(queue.jobs.back());
+                queue.jobs.pop_back();
+                ++numSteals;
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    // No jobs are added while running, so once both the own deque and every
+    // other deque are empty there is nothing left to do
+    void workerLoop(int worker, const JobFunction& jobFunction)
+    {
+        Job job;
+
+        while (popOwn(worker, job) || steal(worker, job))
+            jobFunction(worker, job);
+    }
+
+    std::vector<Queue> queues;
+    int numJobsAdded = 0;
+    std::atomic<int> numSteals { 0 };
+
+    JUCE_DECLARE_NON_COPYABLE(WorkStealingScheduler)
+};
@@ -0,0 +1,466 @@
+/*
+  ==============================================================================
+
+    Main.cpp
+    Created: 17 Oct 2026 9:14:36pm
+    Author:  Leif Rehtanz
+
+    Micro-benchmarks for the DSP hot paths: times every benchmark over a
+    sweep of block sizes, channel counts and sample rates, writes the
+    results as JSON and compares them against a stored baseline.
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include <iostream>
+#include <map>
+#include "../../../Source/AudioProcessorManager.h"
+#include "../../../Source/DeEssEngineRegistry.h"
+#include "../../../Source/DeEssKernels.h"
+#include "../../../Source/MultichannelLinkwitzRiley.h"
+
+namespace
+{
+    void printUsage()
+    {
+        std::cout << "Usage: DeEssDoctorBenchmarks [options]\n"
+                     "\n"
+                     "  --filter=<text>        Only run benchmarks whose name contains this text\n"
+                     "  --block-sizes=<list>   Comma-separated (default 32,64,128,256,512,1024,2048,4096)\n"
+                     "  --channels=<list>      Comma-separated (default 1,2,6,16)\n"
+                     "  --sample-rates=<list>  Comma-separated, in Hz (default 44100,48000,96000,192000)\n"
+                     "  --seconds=<s>          Audio processed per run (default 1)\n"
+                     "  --runs=<n>             Timed runs per case, after one warm-up run; the\n"
+                     "                         fastest is reported (default 5)\n"
+                     "  --json=<file>          Write the results to this file\n"
+                     "  --baseline=<file>      Compare against results written earlier with --json\n"
+                     "  --tolerance=<percent>  Slow-down that counts as a regression (default 10)\n"
+                     "  --list                 List the benchmarks and exit\n"
+                     "  --help                 Show this message\n"
+                     "\n"
+                     "ns/sample is wall time per sample of one channel; x realtime is audio\n"
+                     "duration (all channels at once) divided by wall time. Exits with 1 if any\n"
+                     "case is slower than the baseline by more than the tolerance.\n";
+    }
+
+    float getFloatOption(const juce::ArgumentList& args, juce::StringRef option, float defaultValue)
+    {
+        return args.containsOption(option) ? args.getValueForOption(option).getFloatValue() : defaultValue;
+    }
+
+    juce::Array<int> getIntListOption(const juce::ArgumentList& args, juce::StringRef option, const juce::Array<int>& defaultValues)
+    {
+        if (! args.containsOption(option))
+            return defaultValues;
+
+        juce::Array<int> values;
+
+        for (auto& token : juce::StringArray::fromTokens(args.getValueForOption(option), ",", {}))
+            if (token.getIntValue() > 0)
+                values.add(token.getIntValue());
+
+        return values;
+    }
+
+    struct Case
+    {
+        int blockSize = 0;
+        int numChannels = 0;
+        double sampleRate = 0.0;
+    };
+
+    using BlockFunction = std::function<void(juce::AudioBuffer<float>& block)>;
+
+    struct Benchmark
+    {
+        juce::String name;
+
+        // Sets up whatever is measured for the case and returns the call made
+        // for every block; only that call is timed
+        std::function<BlockFunction(const Case&)> prepare;
+    };
+
+    // Same values for every case, so sibilant detection does comparable work throughout
+    constexpr float thresholdDb = -30.0f;
+    constexpr float mixDb = -12.0f;
+    constexpr float frequency = 6500.0f;
+    constexpr int hysteresisSamples = 50;
+
+    juce::String toIdentifier(const juce::String& name)
+    {
+        return name.toLowerCase().replaceCharacter(' ', '-');
+    }
+
+    juce::Array<Benchmark> createBenchmarks()
+    {
+        juce::Array<Benchmark> benchmarks;
+
+        // The whole audio-thread path, including parameter hand-off and slicing
+        for (const auto& entry : DeEssEngineRegistry::getEntries())
+        {
+            const auto algorithm = entry.algorithm;
+
+            benchmarks.add({ "manager/" + toIdentifier(entry.name), [algorithm] (const Case& c) -> BlockFunction
+            {
+                auto manager = std::make_shared<AudioProcessorManager>();
+                manager->setDeEssingParameters(thresholdDb, mixDb, frequency, (float) hysteresisSamples);
+                manager->setAlgorithm(algorithm);
+                manager->prepare(c.sampleRate, c.blockSize, c.numChannels);
+
+                return [manager] (juce::AudioBuffer<float>& block) { manager->processBlock(block); };
+            }});
+        }
+
+        // Each algorithm on its own
+        for (const auto& entry : DeEssEngineRegistry::getEntries())
+        {
+            const auto algorithm = entry.algorithm;
+
+            benchmarks.add({ "engine/" + toIdentifier(entry.name), [algorithm] (const Case& c) -> BlockFunction
+            {
+                std::shared_ptr<DeEssEngine> engine = DeEssEngineRegistry::createEngine(algorithm);
+                engine->setParameters(thresholdDb, mixDb, frequency, hysteresisSamples);
+                engine->prepare(c.sampleRate, c.blockSize, c.numChannels);
+
+                return [engine] (juce::AudioBuffer<float>& block)
+                {
+                    engine->process(block, 0, block.getNumSamples());
+                };
+            }});
+        }
+
+        // Control-rate detection against the per-sample gate above; only the
+        // amplitude engine has a sample-domain gate to switch
+        const std::pair<const char*, DeEssEngine::Detection::Mode> detectionModes[] {
+            { "peak", DeEssEngine::Detection::Mode::peak },
+            { "rms", DeEssEngine::Detection::Mode::rms }
+        };
+
+        const auto amplitudeName = toIdentifier(DeEssEngineRegistry::find(DeEssEngineRegistry::Algorithm::amplitudeThreshold)->name);
+
+        for (const auto& [modeName, mode] : detectionModes)
+        {
+            for (int interval : { 16, 32 })
+            {
+                DeEssEngine::Detection detection;
+                detection.mode = mode;
+                detection.controlInterval = interval;
+
+                benchmarks.add({ "engine/" + amplitudeName + "/" + modeName + "-" + juce::String(interval),
+                                 [detection] (const Case& c) -> BlockFunction
+                {
+                    std::shared_ptr<DeEssEngine> engine = DeEssEngineRegistry::createEngine(DeEssEngineRegistry::Algorithm::amplitudeThreshold);
+                    engine->setParameters(thresholdDb, mixDb, frequency, hysteresisSamples);
+                    engine->setDetection(detection);
+                    engine->prepare(c.sampleRate, c.blockSize, c.numChannels);
+
+                    return [engine] (juce::AudioBuffer<float>& block)
+                    {
+                        engine->process(block, 0, block.getNumSamples());
+                    };
+                }});
+            }
+        }
+
+        benchmarks.add({ "crossover", [] (const Case& c) -> BlockFunction
+        {
+            auto crossover = std::make_shared<MultichannelLinkwitzRiley>();
+            crossover->prepare({ c.sampleRate, (juce::uint32) c.blockSize, (juce::uint32) c.numChannels });
+            crossover->setCutoffFrequency(frequency);
+
+            // Outputs must not alias the input: full band first, high band after it
+            auto bands = std::make_shared<juce::AudioBuffer<float>>(2 * c.numChannels, c.blockSize);
+
+            return [crossover, bands] (juce::AudioBuffer<float>& block)
+            {
+                const auto numChannels = (size_t) block.getNumChannels();
+                const auto numSamples = (size_t) block.getNumSamples();
+
+                juce::dsp::AudioBlock<const float> input(block.getArrayOfReadPointers(), numChannels, numSamples);
+                auto fullBand = juce::dsp::AudioBlock<float>(*bands).getSubsetChannelBlock(0, numChannels);
+                auto highBand = juce::dsp::AudioBlock<float>(*bands).getSubsetChannelBlock(numChannels, numChannels);
+
+                crossover->processCrossover(input, fullBand, highBand);
+            };
+        }});
+
+        // Gate and mix loops of every kernel variant this CPU can run
+        for (const auto* kernels : DeEssKernels::getAvailableKernels())
+        {
+            benchmarks.add({ juce::String("kernels/") + kernels->name, [kernels] (const Case& c) -> BlockFunction
+            {
+                auto sibilant = std::make_shared<juce::AudioBuffer<float>>(c.numChannels, c.blockSize);
+                auto counters = std::make_shared<std::vector<int>>((size_t) c.numChannels, 0);
+                const auto threshold = juce::Decibels::decibelsToGain(thresholdDb);
+                const auto gain = juce::Decibels::decibelsToGain(mixDb);
+
+                return [kernels, sibilant, counters, threshold, gain] (juce::AudioBuffer<float>& block)
+                {
+                    const int numSamples = block.getNumSamples();
+
+                    for (int channel = 0; channel < block.getNumChannels(); ++channel)
+                    {
+                        auto* data = block.getWritePointer(channel);
+                        auto* band = sibilant->getWritePointer(channel);
+
+                        // The block itself stands in for the sibilant band
+                        std::copy(data, data + numSamples, band);
+                        kernels->hysteresisGate(data, band, numSamples, threshold, nullptr,
+                                                hysteresisSamples, (*counters)[(size_t) channel]);
+                        kernels->mixSibilants(data, data, band, gain, nullptr, numSamples);
+                    }
+                };
+            }});
+        }
+
+        return benchmarks;
+    }
+
+    struct Result
+    {
+        juce::String getKey() const
+        {
+            return benchmark + " " + juce::String(testCase.blockSize) + "/" + juce::String(testCase.numChannels)
+                 + "/" + juce::String(juce::roundToInt(testCase.sampleRate));
+        }
+
+        juce::String benchmark;
+        Case testCase;
+        double nsPerSample = 0.0;
+        double realtimeFactor = 0.0;
+    };
+
+    // Quiet noise with a loud burst every quarter second, so the gate both
+    // opens and holds. Seeded, so every run and every build sees the same input.
+    juce::AudioBuffer<float> createTestSignal(int numChannels, int numSamples, double sampleRate)
+    {
+        juce::AudioBuffer<float> signal(numChannels, numSamples);
+        juce::Random random(0x5eed);
+
+        const int burstPeriod = juce::jmax(1, (int) (sampleRate * 0.25));
+        const int burstLength = (int) (sampleRate * 0.06);
+
+        for (int channel = 0; channel < numChannels; ++channel)
+        {
+            auto* data = signal.getWritePointer(channel);
+
+            for (int i = 0; i < numSamples; ++i)
+            {
+                const float level = (i % burstPeriod) < burstLength ? 0.5f : 0.02f;
+                data[i] = level * (random.nextFloat() * 2.0f - 1.0f);
+            }
+        }
+
+        return signal;
+    }
+
+    Result runCase(const Benchmark& benchmark, const Case& testCase, double seconds, int numRuns)
+    {
+        const int numSamples = juce::jmax(testCase.blockSize, juce::roundToInt(seconds * testCase.sampleRate));
+        const auto signal = createTestSignal(testCase.numChannels, numSamples, testCase.sampleRate);
+        juce::AudioBuffer<float> work(testCase.numChannels, numSamples);
+
+        auto processBlock = benchmark.prepare(testCase);
+        double fastestSeconds = std::numeric_limits<double>::max();
+
+        // Run 0 warms up caches and filter state and isn't counted
+        for (int run = 0; run <= numRuns; ++run)
+        {
+            work.makeCopyOf(signal, true);
+
+            const auto startTicks = juce::Time::getHighResolutionTicks();
+
+            for (int start = 0; start < numSamples; start += testCase.blockSize)
+            {
+                juce::AudioBuffer<float> block(work.getArrayOfWritePointers(), testCase.numChannels, start,
+                                               juce::jmin(testCase.blockSize, numSamples - start));
+                processBlock(block);
+            }
+
+            const auto elapsed = juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - startTicks);
+
+            if (run > 0)
+                fastestSeconds = juce::jmin(fastestSeconds, elapsed);
+        }
+
+        fastestSeconds = juce::jmax(fastestSeconds, 1.0e-9);
+
+        Result result;
+        result.benchmark = benchmark.name;
+        result.testCase = testCase;
+        result.nsPerSample = fastestSeconds * 1.0e9 / ((double) numSamples * testCase.numChannels);
+        result.realtimeFactor = (double) numSamples / testCase.sampleRate / fastestSeconds;
+        return result;
+    }
+
+    juce::var toJson(const juce::Array<Result>& results)
+    {
+        juce::Array<juce::var> cases;
+
+        for (const auto& result : results)
+        {
+            juce::DynamicObject::Ptr item = new juce::DynamicObject();
+            item->setProperty("benchmark", result.benchmark);
+            item->setProperty("blockSize", result.testCase.blockSize);
+            item->setProperty("channels", result.testCase.numChannels);
+            item->setProperty("sampleRate", result.testCase.sampleRate);
+            item->setProperty("nsPerSample", result.nsPerSample);
+            item->setProperty("realtimeFactor", result.realtimeFactor);
+            cases.add(item.get());
+        }
+
+        juce::DynamicObject::Ptr root = new juce::DynamicObject();
+        root->setProperty("cpu", juce::SystemStats::getCpuModel());
+        root->setProperty("kernels", juce::String(DeEssKernels::getBestKernels().name));
+        root->setProperty("date", juce::Time::getCurrentTime().toISO8601(true));
+        root->setProperty("results", cases);
+        return root.get();
+    }
+
+    // ns/sample by Result::getKey(); false if the file isn't a results file
+    bool loadBaseline(const juce::File& file, std::map<juce::String, double>& baseline)
+    {
+        const auto json = juce::JSON::parse(file);
+        const auto* cases = json["results"].getArray();
+
+        if (cases == nullptr)
+            return false;
+
+        for (const auto& item : *cases)
+        {
+            Result result;
+            result.benchmark = item["benchmark"].toString();
+            result.testCase.blockSize = (int) item["blockSize"];
+            result.testCase.numChannels = (int) item["channels"];
+            result.testCase.sampleRate = (double) item["sampleRate"];
+
+            baseline[result.getKey()] = (double) item["nsPerSample"];
+        }
+
+        return true;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    juce::ArgumentList args(argc, argv);
+
+    if (args.containsOption("--help|-h"))
+    {
+        printUsage();
+        return 0;
+    }
+
+    // Detect the kernel variant up front, as the app does, so no case pays for it
+    const auto& bestKernels = DeEssKernels::getBestKernels();
+
+    const auto filter = args.getValueForOption("--filter");
+    juce::Array<Benchmark> benchmarks;
+
+    for (const auto& benchmark : createBenchmarks())
+        if (filter.isEmpty() || benchmark.name.containsIgnoreCase(filter))
+            benchmarks.add(benchmark);
+
+    if (args.containsOption("--list"))
+    {
+        for (const auto& benchmark : benchmarks)
+            std::cout << benchmark.name << "\n";
+
+        return 0;
+    }
+
+    const auto blockSizes = getIntListOption(args, "--block-sizes", { 32, 64, 128, 256, 512, 1024, 2048, 4096 });
+    const auto channelCounts = getIntListOption(args, "--channels", { 1, 2, 6, 16 });
+    const auto sampleRates = getIntListOption(args, "--sample-rates", { 44100, 48000, 96000, 192000 });
+    const double seconds = juce::jmax(0.01f, getFloatOption(args, "--seconds", 1.0f));
+    const int numRuns = juce::jmax(1, (int) getFloatOption(args, "--runs", 5.0f));
+    const double tolerance = getFloatOption(args, "--tolerance", 10.0f) / 100.0;
+
+    if (benchmarks.isEmpty() || blockSizes.isEmpty() || channelCounts.isEmpty() || sampleRates.isEmpty())
+    {
+        printUsage();
+        return 1;
+    }
+
+    std::map<juce::String, double> baseline;
+    const auto baselinePath = args.getValueForOption("--baseline");
+
+    if (baselinePath.isNotEmpty())
+    {
+        const auto baselineFile = juce::File::getCurrentWorkingDirectory().getChildFile(baselinePath);
+
+        if (! loadBaseline(baselineFile, baseline))
+        {
+            std::cerr << "Could not read baseline " << baselineFile.getFullPathName() << "\n";
+            return 1;
+        }
+    }
+
+    std::cout << "CPU: " << juce::SystemStats::getCpuModel() << ", kernels: " << bestKernels.name << "\n\n";
+
+    juce::Array<Result> results;
+    int numRegressions = 0;
+
+    for (const auto& benchmark : benchmarks)
+    {
+        for (const auto sampleRate : sampleRates)
+        {
+            for (const auto numChannels : channelCounts)
+            {
+                for (const auto blockSize : blockSizes)
+                {
+                    const auto result = runCase(benchmark, { blockSize, numChannels, (double) sampleRate }, seconds, numRuns);
+                    results.add(result);
+
+                    std::cout << result.getKey().paddedRight(' ', 52)
+                              << juce::String(result.nsPerSample, 2).paddedLeft(' ', 10) << " ns/sample"
+                              << juce::String(result.realtimeFactor, 1).paddedLeft(' ', 12) << "x realtime";
+
+                    const auto baselineCase = baseline.find(result.getKey());
+
+                    if (baselineCase != baseline.end() && baselineCase->second > 0.0)
+                    {
+                        const auto change = result.nsPerSample / baselineCase->second - 1.0;
+                        const bool regressed = change > tolerance;
+
+                        std::cout << "  " << (change >= 0.0 ? "+" : "") << juce::String(change * 100.0, 1) << "%"
+                                  << (regressed ? "  REGRESSION" : "");
+
+                        if (regressed)
+                            ++numRegressions;
+                    }
+                    else if (! baseline.empty())
+                    {
+                        std::cout << "  (not in baseline)";
+                    }
+
+                    std::cout << "\n";
+                }
+            }
+        }
+    }
+
+    const auto jsonPath = args.getValueForOption("--json");
+
+    if (jsonPath.isNotEmpty())
+    {
+        const auto jsonFile = juce::File::getCurrentWorkingDirectory().getChildFile(jsonPath);
+
+        if (! jsonFile.replaceWithText(juce::JSON::toString(toJson(results))))
+        {
+            std::cerr << "Could not write " << jsonFile.getFullPathName() << "\n";
+            return 1;
+        }
+    }
+
+    std::cout << "\n" << results.size() << " cases";
+
+    if (! baseline.empty())
+        std::cout << ", " << numRegressions << " more than " << juce::String(tolerance * 100.0, 1)
+                  << "% slower than the baseline";
+
+    std::cout << "\n";
+
+    return numRegressions == 0 ? 0 : 1;
+}
@@ -0,0 +1,124 @@
+/*
+  ==============================================================================
+
+    AlgorithmSwitchTests.cpp
+    Created: 18 Oct 2026 6:02:31pm
+    Author:  Leif Rehtanz
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "../../../Source/AudioProcessorManager.h"
+
+// Switches algorithms in the middle of playback and checks that the audio
+// stays put: the reported latency never changes, and with the threshold out
+// of reach the output is the input delayed by that latency, through the
+// crossfades as well. Only low tones go in, which the crossovers' allpass
+// shifts by a couple of degrees at most.
+class AlgorithmSwitchTests : public juce::UnitTest
+{
+public:
+    AlgorithmSwitchTests() : juce::UnitTest("Algorithm switches", "DeEssDoctor") {}
+
+    void runTest() override
+    {
+        for (const auto& entry : DeEssEngineRegistry::getEntries())
+        {
+            for (const auto& other : DeEssEngineRegistry::getEntries())
+            {
+                if (other.algorithm == entry.algorithm)
+                    continue;
+
+                beginTest(juce::String(entry.name) + " to " + other.name + " and back");
+                expectSwitchesAreSeamless(entry.algorithm, other.algorithm);
+            }
+        }
+    }
+
+private:
+    static constexpr double sampleRate = 48000.0;
+    static constexpr int preparedBlockSize = 256;
+    static constexpr double lowestFrequency = 100.0;
+    static constexpr float toneLevel = 0.5f;
+
+    // A different tone per channel, each starting from zero so there's no
+    // step at the start
+    static double getFrequency(int channel)  { return lowestFrequency * (1.0 + 0.5 * channel); }
+
+    static float getInputSample(int channel, juce::int64 index)
+    {
+        const auto phase = juce::MathConstants<double>::twoPi * getFrequency(channel) * (double) index / sampleRate;
+        return toneLevel * (float) std::sin(phase);
+    }
+
+    void expectSwitchesAreSeamless(DeEssEngineRegistry::Algorithm first, DeEssEngineRegistry::Algorithm second)
+    {
+        constexpr int numChannels = 2;
+        AudioProcessorManager manager;
+        manager.setDeEssingParameters(0.0f, -12.0f, 6000.0f, 50.0f);
+        manager.setAlgorithm(first);
+        manager.prepare(sampleRate, preparedBlockSize, numChannels);
+
+        const int latency = manager.getLatencySamples();
+        const auto switchSamples = { (juce::int64) (0.5 * sampleRate), (juce::int64) (1.0 * sampleRate) };
+        const auto numSamples = (juce::int64) (1.5 * sampleRate);
+
+        // The crossovers ring for a moment as the tones start; checks begin once that has settled
+        const auto firstChecked = latency + (juce::int64) (0.1 * sampleRate);
+
+        juce::AudioBuffer<float> buffer(numChannels, 3 * preparedBlockSize);
+        auto& random = getRandom();
+        float largestError = 0.0f, largestStepError = 0.0f;
+        bool latencyMoved = false;
+        float previous[numChannels] {};
+
+        for (juce::int64 position = 0; position < numSamples;)
+        {
+            const int blockSize = (int) juce::jmin((juce::int64) 1 + random.nextInt(buffer.getNumSamples()), numSamples - position);
+
+            for (const auto switchSample : switchSamples)
+                if (position <= switchSample && switchSample < position + blockSize)
+                    manager.setAlgorithm(switchSample == *switchSamples.begin() ? second : first);
+
+            for (int channel = 0; channel < numChannels; ++channel)
+                for (int i = 0; i < blockSize; ++i)
+                    buffer.setSample(channel, i, getInputSample(channel, position + i));
+
+            juce::AudioBuffer<float> hostBlock(buffer.getArrayOfWritePointers(), numChannels, blockSize);
+            manager.processBlock(hostBlock);
+            manager.releaseRetiredEngine();
+
+            latencyMoved = latencyMoved || manager.getLatencySamples() != latency;
+
+            for (int channel = 0; channel < numChannels; ++channel)
+            {
+                for (int i = 0; i < blockSize; ++i)
+                {
+                    const auto index = position + i;
+                    const auto sample = hostBlock.getSample(channel, i);
+
+                    if (index >= firstChecked)
+                        largestError = juce::jmax(largestError, std::abs(sample - getInputSample(channel, index - latency)));
+
+                    // A click shows as a step between samples that the delayed input doesn't take
+                    if (index >= firstChecked)
+                    {
+                        const auto inputStep = getInputSample(channel, index - latency) - getInputSample(channel, index - latency - 1);
+                        largestStepError = juce::jmax(largestStepError, std::abs(sample - previous[channel] - inputStep));
+                    }
+
+                    previous[channel] = sample;
+                }
+            }
+
+            position += blockSize;
+        }
+
+        expect(! latencyMoved, "The reported latency moved");
+        expect(largestError < 0.05f, "Output strays from the delayed input by " + juce::String(largestError));
+        expect(largestStepError < 2.0e-3f, "Output jumps by " + juce::String(largestStepError));
+    }
+};
+
+static AlgorithmSwitchTests algorithmSwitchTests;
@@ -0,0 +1,66 @@
+/*
+  ==============================================================================
+
+    ChunkedRenderTests.cpp
+    Created: 18 Oct 2026 7:31:52pm
+    Author:  Leif Rehtanz
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "../../../Source/OfflineRenderer.h"
+#include "TestAudio.h"
+
+// Renders the same audio in one pass and split into chunks over several
+// threads, with per-sample detection, and expects identical output without
+// any chunk's start being rendered again: each pre-roll has to bring the
+// crossover and hysteresis state exactly to where the previous chunk left it.
+class ChunkedRenderTests : public juce::UnitTest
+{
+public:
+    ChunkedRenderTests() : juce::UnitTest("Chunked rendering", "DeEssDoctor") {}
+
+    void runTest() override
+    {
+        const auto input = TestAudio::createSpeechLikeSignal(getRandom(), sampleRate);
+
+        // Chunk lengths and block sizes that don't divide each other or the input
+        const ChunkLayout layouts[] { { 0.5, 0.1, 50.0f, 2, 512 },
+                                      { 0.37, 0.1, 120.0f, 4, 100 },
+                                      { 1.1, 0.2, 5.0f, 3, 37 } };
+
+        for (const auto& layout : layouts)
+        {
+            beginTest(juce::String(layout.chunkSeconds) + " s chunks on " + juce::String(layout.numThreads)
+                      + " threads, " + juce::String(layout.blockSize) + "-sample blocks");
+
+            OfflineRenderer::Settings settings;
+            settings.threshold = -30.0f;
+            settings.mixLevel = -12.0f;
+            settings.frequency = 6000.0f;
+            settings.hysteresis = layout.hysteresis;
+            settings.detection.mode = DeEssEngine::Detection::Mode::perSample;
+            settings.blockSize = layout.blockSize;
+            settings.numThreads = layout.numThreads;
+            settings.chunkSeconds = layout.chunkSeconds;
+            settings.preRollSeconds = layout.preRollSeconds;
+
+            TestAudio::expectChunkedMatchesSinglePass(*this, input, sampleRate, settings);
+        }
+    }
+
+private:
+    static constexpr double sampleRate = 48000.0;
+
+    struct ChunkLayout
+    {
+        double chunkSeconds;
+        double preRollSeconds;
+        float hysteresis;
+        int numThreads;
+        int blockSize;
+    };
+};
+
+static ChunkedRenderTests chunkedRenderTests;
@@ -0,0 +1,131 @@
+/*
+  ==============================================================================
+
+    ControlRateDetectionTests.cpp
+    Created: 18 Oct 2026 3:12:46pm
+    Author:  Leif Rehtanz
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "../../../Source/AmplitudeThresholdEngine.h"
+#include "../../../Source/OfflineRenderer.h"
+#include "TestAudio.h"
+
+// Checks peak and RMS detection in the amplitude threshold engine: the output
+// doesn't depend on how the audio is split into blocks, it stays close to
+// per-sample detection, and chunked offline renders match single-pass ones
+// without re-rendering any chunk.
+class ControlRateDetectionTests : public juce::UnitTest
+{
+public:
+    ControlRateDetectionTests() : juce::UnitTest("Control-rate detection", "DeEssDoctor") {}
+
+    void runTest() override
+    {
+        const auto input = TestAudio::createSpeechLikeSignal(getRandom(), sampleRate);
+        const auto perSample = processInBlocks(input, {}, 256);
+
+        using Mode = DeEssEngine::Detection::Mode;
+        const std::pair<const char*, Mode> modes[] { { "Peak", Mode::peak }, { "RMS", Mode::rms } };
+
+        // Measured differences are about -38, -35 and -31 dB; the bounds leave
+        // room for other random input
+        const std::pair<int, double> maxDifferencesDb[] { { 16, -34.0 }, { 32, -31.0 }, { 64, -28.0 } };
+
+        for (const auto& [modeName, mode] : modes)
+        {
+            for (const auto& [interval, maxDifferenceDb] : maxDifferencesDb)
+            {
+                DeEssEngine::Detection detection;
+                detection.mode = mode;
+                detection.controlInterval = interval;
+
+                const auto name = juce::String(modeName) + " every " + juce::String(interval) + " samples";
+                const auto output = processInBlocks(input, detection, 256);
+
+                beginTest(name + ", block size doesn't matter");
+                expect(TestAudio::bitwiseEqual(output, processInBlocks(input, detection, 100)), "Differs with 100-sample blocks");
+                expect(TestAudio::bitwiseEqual(output, processInBlocks(input, detection, 37)), "Differs with 37-sample blocks");
+
+                beginTest(name + ", close to per-sample detection");
+                const auto differenceDb = getDifferenceDb(output, perSample);
+                expect(differenceDb < maxDifferenceDb,
+                       "Differs from per-sample detection by " + juce::String(differenceDb, 1) + " dB");
+            }
+
+            // The second layout's chunk length, pre-roll and hysteresis aren't
+            // multiples of the interval
+            for (const auto& layout : { ChunkLayout { 0.7, 0.1, 50.0f }, ChunkLayout { 0.70013, 0.1003, 37.0f } })
+            {
+                beginTest(juce::String(modeName) + ", chunked render of " + juce::String(layout.chunkSeconds) + " s chunks");
+
+                OfflineRenderer::Settings settings;
+                settings.threshold = threshold;
+                settings.mixLevel = mixLevel;
+                settings.frequency = frequency;
+                settings.hysteresis = layout.hysteresis;
+                settings.detection.mode = mode;
+                settings.detection.controlInterval = 16;
+                settings.blockSize = 500;
+                settings.numThreads = 3;
+                settings.chunkSeconds = layout.chunkSeconds;
+                settings.preRollSeconds = layout.preRollSeconds;
+
+                TestAudio::expectChunkedMatchesSinglePass(*this, input, sampleRate, settings);
+            }
+        }
+    }
+
+private:
+    static constexpr double sampleRate = 48000.0;
+    static constexpr float threshold = -30.0f;
+    static constexpr float mixLevel = -12.0f;
+    static constexpr float frequency = 6000.0f;
+    static constexpr int hysteresis = 50;
+
+    struct ChunkLayout
+    {
+        double chunkSeconds;
+        double preRollSeconds;
+        float hysteresis;
+    };
+
+    static juce::AudioBuffer<float> processInBlocks(const juce::AudioBuffer<float>& input,
+                                                    const DeEssEngine::Detection& detection, int blockSize)
+    {
+        AmplitudeThresholdEngine engine;
+        engine.setParameters(threshold, mixLevel, frequency, hysteresis);
+        engine.setDetection(detection);
+        engine.prepare(sampleRate, blockSize, input.getNumChannels());
+
+        juce::AudioBuffer<float> output;
+        output.makeCopyOf(input);
+
+        for (int start = 0; start < output.getNumSamples(); start += blockSize)
+            engine.process(output, start, juce::jmin(blockSize, output.getNumSamples() - start));
+
+        return output;
+    }
+
+    // Energy of the difference relative to the reference's
+    static double getDifferenceDb(const juce::AudioBuffer<float>& output, const juce::AudioBuffer<float>& reference)
+    {
+        double differenceEnergy = 0.0, referenceEnergy = 0.0;
+
+        for (int channel = 0; channel < reference.getNumChannels(); ++channel)
+        {
+            for (int i = 0; i < reference.getNumSamples(); ++i)
+            {
+                const double difference = output.getSample(channel, i) - reference.getSample(channel, i);
+                differenceEnergy += difference * difference;
+                referenceEnergy += (double) reference.getSample(channel, i) * reference.getSample(channel, i);
+            }
+        }
+
+        return 10.0 * std::log10(differenceEnergy / referenceEnergy);
+    }
+};
+
+static ControlRateDetectionTests controlRateDetectionTests;
@@ -0,0 +1,104 @@
+/*
+  ==============================================================================
+
+    CrossoverTests.cpp
+    Created: 18 Oct 2026 8:40:26pm
+    Author:  Leif Rehtanz
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "../../../Source/MultichannelLinkwitzRiley.h"
+
+// Checks MultichannelLinkwitzRiley against juce::dsp::LinkwitzRileyFilter,
+// channel by channel: the full band must follow the all-pass filter and the
+// high band the high-pass one. The high band is computed as all-pass minus
+// low-pass rather than by JUCE's high-pass stage, so the two only agree to
+// within float rounding. Channel counts cover a single channel, part of a
+// lane group and several groups with a partial one at the end.
+class CrossoverTests : public juce::UnitTest
+{
+public:
+    CrossoverTests() : juce::UnitTest("Multichannel crossover", "DeEssDoctor") {}
+
+    void runTest() override
+    {
+        for (const float cutoff : { 2000.0f, 8000.0f })
+        {
+            for (const int numChannels : { 1, 3, 5, 9, 16 })
+            {
+                beginTest(juce::String(numChannels) + " channels, " + juce::String((int) cutoff) + " Hz");
+                expectMatchesJuceFilters(numChannels, cutoff);
+            }
+        }
+    }
+
+private:
+    static constexpr double sampleRate = 48000.0;
+    static constexpr int maxBlockSize = 512;
+    static constexpr int numSamples = 24000;
+
+    // About 16 float epsilons at full scale; measured errors stay under 5e-7
+    static constexpr float tolerance = 2.0e-6f;
+
+    void expectMatchesJuceFilters(int numChannels, float cutoff)
+    {
+        const juce::dsp::ProcessSpec spec { sampleRate, (juce::uint32) maxBlockSize, (juce::uint32) numChannels };
+
+        MultichannelLinkwitzRiley crossover;
+        crossover.setCutoffFrequency(cutoff);
+        crossover.prepare(spec);
+
+        juce::dsp::LinkwitzRileyFilter<float> allPass, highPass;
+        allPass.setType(juce::dsp::LinkwitzRileyFilterType::allpass);
+        highPass.setType(juce::dsp::LinkwitzRileyFilterType::highpass);
+
+        for (auto* filter : { &allPass, &highPass })
+        {
+            filter->setCutoffFrequency(cutoff);
+            filter->prepare(spec);
+        }
+
+        // Independent white noise per channel, so swapped channels show
+        auto& random = getRandom();
+        juce::AudioBuffer<float> input(numChannels, numSamples);
+
+        for (int channel = 0; channel < numChannels; ++channel)
+            for (int i = 0; i < numSamples; ++i)
+                input.setSample(channel, i, random.nextFloat() * 2.0f - 1.0f);
+
+        juce::AudioBuffer<float> fullBand(numChannels, maxBlockSize), highBand(numChannels, maxBlockSize);
+        float largestFullBandError = 0.0f, largestHighBandError = 0.0f;
+
+        for (int start = 0; start < numSamples;)
+        {
+            const int length = juce::jmin(1 + random.nextInt(maxBlockSize), numSamples - start);
+
+            juce::dsp::AudioBlock<const float> inputBlock(input.getArrayOfReadPointers(), (size_t) numChannels,
+                                                          (size_t) start, (size_t) length);
+            juce::dsp::AudioBlock<float> fullBandBlock(fullBand);
+            juce::dsp::AudioBlock<float> highBandBlock(highBand);
+            crossover.processCrossover(inputBlock, fullBandBlock, highBandBlock);
+
+            for (int channel = 0; channel < numChannels; ++channel)
+            {
+                for (int i = 0; i < length; ++i)
+                {
+                    const auto x = input.getSample(channel, start + i);
+                    largestFullBandError = juce::jmax(largestFullBandError,
+                                                      std::abs(fullBand.getSample(channel, i) - allPass.processSample(channel, x)));
+                    largestHighBandError = juce::jmax(largestHighBandError,
+                                                      std::abs(highBand.getSample(channel, i) - highPass.processSample(channel, x)));
+                }
+            }
+
+            start += length;
+        }
+
+        expect(largestFullBandError <= tolerance, "Full band differs from the all-pass filter by " + juce::String(largestFullBandError));
+        expect(largestHighBandError <= tolerance, "High band differs from the high-pass filter by " + juce::String(largestHighBandError));
+    }
+};
+
+static CrossoverTests crossoverTests;
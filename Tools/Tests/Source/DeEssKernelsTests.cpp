@@ -0,0 +1,209 @@
+/*
+  ==============================================================================
+
+    DeEssKernelsTests.cpp
+    Created: 18 Oct 2026 10:06:55am
+    Author:  Leif Rehtanz
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "../../../Source/DeEssKernels.h"
+
+// Runs every kernel variant this CPU can run against the scalar reference and
+// requires bit-identical output. Lengths cover empty input, everything up to a
+// few AVX-512 vectors and some odd sizes beyond; offsets into the buffers
+// cover every alignment of the first sample, so the vector loops' heads and
+// tails all get exercised.
+class DeEssKernelsTests : public juce::UnitTest
+{
+public:
+    DeEssKernelsTests() : juce::UnitTest("DeEss kernels", "DeEssDoctor") {}
+
+    void runTest() override
+    {
+        const auto& reference = DeEssKernels::getReferenceKernels();
+        const auto available = DeEssKernels::getAvailableKernels();
+
+        beginTest("Reference kernels are listed first");
+        expect(! available.isEmpty() && available.getFirst() == &reference);
+
+        for (const auto* kernels : available)
+        {
+            if (kernels == &reference)
+                continue;
+
+            beginTest(juce::String(kernels->name) + " hysteresis gate");
+            expectMatch(checkHysteresisGate(*kernels, reference));
+
+            beginTest(juce::String(kernels->name) + " mix");
+            expectMatch(checkMixSibilants(*kernels, reference));
+        }
+    }
+
+private:
+    static constexpr int maxOffset = 15;    // One AVX-512 vector less a sample
+    static constexpr float threshold = 0.25f;
+    static constexpr float gain = 0.3f;
+
+    // Each check stops at the first mismatch and describes it
+    void expectMatch(const juce::String& mismatch)
+    {
+        expect(mismatch.isEmpty(), "Differs from the reference at " + mismatch);
+    }
+
+    static juce::Array<int> getLengths()
+    {
+        juce::Array<int> lengths;
+
+        for (int length = 0; length <= 70; ++length)
+            lengths.add(length);
+
+        for (int length : { 127, 128, 129, 255, 256, 257, 1000, 1021 })
+            lengths.add(length);
+
+        return lengths;
+    }
+
+    // Mostly quiet with loud stretches, so the gate both opens and closes
+    // inside a vector; sprinkled with values exactly at the threshold, its
+    // negation and both zeros, where a sign or comparison slip would show
+    void fillSignal(float* data, int numSamples)
+    {
+        auto& random = getRandom();
+        bool loud = false;
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            if (random.nextInt(24) == 0)
+                loud = ! loud;
+
+            const auto value = (random.nextFloat() * 2.0f - 1.0f) * (loud ? 0.8f : 0.2f);
+
+            switch (random.nextInt(40))
+            {
+                case 0:  data[i] = threshold; break;
+                case 1:  data[i] = -threshold; break;
+                case 2:  data[i] = 0.0f; break;
+                case 3:  data[i] = -0.0f; break;
+                default: data[i] = value; break;
+            }
+        }
+    }
+
+    // Positive values around the threshold, for per-sample thresholds and gains
+    void fillLevels(float* data, int numSamples)
+    {
+        auto& random = getRandom();
+
+        for (int i = 0; i < numSamples; ++i)
+            data[i] = threshold * (0.5f + random.nextFloat());
+    }
+
+    static bool bitwiseEqual(const float* a, const float* b, int numSamples)
+    {
+        return numSamples == 0 || std::memcmp(a, b, sizeof(float) * (size_t) numSamples) == 0;
+    }
+
+    static juce::String describe(int length, int offset)
+    {
+        return "length " + juce::String(length) + ", offset " + juce::String(offset);
+    }
+
+    juce::String checkHysteresisGate(const DeEssKernels::KernelSet& kernels, const DeEssKernels::KernelSet& reference)
+    {
+        const int maxLength = getLengths().getLast();
+        const int size = maxLength + maxOffset;
+        std::vector<float> original((size_t) maxLength), sibilant((size_t) maxLength), thresholds((size_t) size);
+        std::vector<float> originalOut((size_t) size), sibilantOut((size_t) size);
+        std::vector<float> originalRef((size_t) maxLength), sibilantRef((size_t) maxLength);
+
+        for (const int length : getLengths())
+        {
+            for (int offset = 0; offset <= maxOffset; ++offset)
+            {
+                fillSignal(sibilant.data(), length);
+                fillSignal(original.data(), length);
+                fillLevels(thresholds.data() + offset, length);
+
+                for (const bool perSampleThresholds : { false, true })
+                {
+                    for (const int hysteresisSamples : { 1, 3, 50 })
+                    {
+                        for (const int initialCounter : { 0, 2, 80 })
+                        {
+                            std::copy(original.begin(), original.begin() + length, originalRef.begin());
+                            std::copy(sibilant.begin(), sibilant.begin() + length, sibilantRef.begin());
+                            std::copy(original.begin(), original.begin() + length, originalOut.begin() + offset);
+                            std::copy(sibilant.begin(), sibilant.begin() + length, sibilantOut.begin() + offset);
+
+                            const auto* perSample = perSampleThresholds ? thresholds.data() + offset : nullptr;
+                            int counterRef = initialCounter;
+                            int counter = initialCounter;
+
+                            reference.hysteresisGate(originalRef.data(), sibilantRef.data(), length,
+                                                     threshold, perSample, hysteresisSamples, counterRef);
+                            kernels.hysteresisGate(originalOut.data() + offset, sibilantOut.data() + offset, length,
+                                                   threshold, perSample, hysteresisSamples, counter);
+
+                            const bool matches = counter == counterRef
+                                              && bitwiseEqual(originalOut.data() + offset, originalRef.data(), length)
+                                              && bitwiseEqual(sibilantOut.data() + offset, sibilantRef.data(), length);
+
+                            if (! matches)
+                                return describe(length, offset) + ", hysteresis " + juce::String(hysteresisSamples)
+                                     + ", counter " + juce::String(initialCounter)
+                                     + (perSampleThresholds ? ", per-sample thresholds" : "");
+                        }
+                    }
+                }
+            }
+        }
+
+        return {};
+    }
+
+    juce::String checkMixSibilants(const DeEssKernels::KernelSet& kernels, const DeEssKernels::KernelSet& reference)
+    {
+        const int maxLength = getLengths().getLast();
+        const int size = maxLength + maxOffset;
+        std::vector<float> original((size_t) size), sibilant((size_t) size), gains((size_t) size);
+        std::vector<float> dest((size_t) size), destRef((size_t) size), inPlace((size_t) size);
+
+        for (const int length : getLengths())
+        {
+            for (int offset = 0; offset <= maxOffset; ++offset)
+            {
+                fillSignal(original.data() + offset, length);
+                fillSignal(sibilant.data() + offset, length);
+                fillLevels(gains.data() + offset, length);
+
+                for (const bool perSampleGains : { false, true })
+                {
+                    const auto* perSample = perSampleGains ? gains.data() + offset : nullptr;
+
+                    reference.mixSibilants(destRef.data(), original.data() + offset, sibilant.data() + offset,
+                                           gain, perSample, length);
+                    kernels.mixSibilants(dest.data() + offset, original.data() + offset, sibilant.data() + offset,
+                                         gain, perSample, length);
+
+                    // The engines mix into the buffer that holds the original
+                    std::copy(original.begin() + offset, original.begin() + offset + length, inPlace.begin() + offset);
+                    kernels.mixSibilants(inPlace.data() + offset, inPlace.data() + offset, sibilant.data() + offset,
+                                         gain, perSample, length);
+
+                    if (! bitwiseEqual(dest.data() + offset, destRef.data(), length)
+                        || ! bitwiseEqual(inPlace.data() + offset, destRef.data(), length))
+                    {
+                        return describe(length, offset) + (perSampleGains ? ", per-sample gains" : "");
+                    }
+                }
+            }
+        }
+
+        return {};
+    }
+};
+
+static DeEssKernelsTests deEssKernelsTests;
@@ -0,0 +1,92 @@
+/*
+  ==============================================================================
+
+    FixedLayoutTests.cpp
+    Created: 18 Oct 2026 8:05:17pm
+    Author:  Leif Rehtanz
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "../../../Source/AmplitudeThresholdEngine.h"
+#include "TestAudio.h"
+
+// Runs the amplitude threshold engine's mono and stereo layouts, at each
+// fixed block size and at one it has no copy for, next to an engine held to
+// the generic path, and expects the same output and state bit for bit. Host
+// blocks shorter than the prepared size and a parameter move on the way make
+// the fixed layouts fall back and ramp.
+class FixedLayoutTests : public juce::UnitTest
+{
+public:
+    FixedLayoutTests() : juce::UnitTest("Fixed-layout processing", "DeEssDoctor") {}
+
+    void runTest() override
+    {
+        const auto signal = TestAudio::createSpeechLikeSignal(getRandom(), sampleRate);
+
+        for (const int numChannels : { 1, 2 })
+        {
+            for (const int blockSize : { 64, 128, 256, 100 })
+            {
+                beginTest(juce::String(numChannels) + " channels, " + juce::String(blockSize) + "-sample blocks");
+                expectMatchesGenericPath(signal, numChannels, blockSize);
+            }
+        }
+    }
+
+private:
+    static constexpr double sampleRate = 48000.0;
+
+    void expectMatchesGenericPath(const juce::AudioBuffer<float>& signal, int numChannels, int blockSize)
+    {
+        AmplitudeThresholdEngine fixedLayout, generic;
+        generic.setUsesFixedLayouts(false);
+
+        for (auto* engine : { &fixedLayout, &generic })
+        {
+            engine->setParameters(-30.0f, -12.0f, 6000.0f, 50);
+            engine->prepare(sampleRate, blockSize, numChannels);
+        }
+
+        juce::AudioBuffer<float> fixedOutput(numChannels, signal.getNumSamples());
+        juce::AudioBuffer<float> genericOutput(numChannels, signal.getNumSamples());
+
+        for (int channel = 0; channel < numChannels; ++channel)
+        {
+            fixedOutput.copyFrom(channel, 0, signal, channel, 0, signal.getNumSamples());
+            genericOutput.copyFrom(channel, 0, signal, channel, 0, signal.getNumSamples());
+        }
+
+        auto& random = getRandom();
+        const int parameterMove = signal.getNumSamples() / 2;
+        bool parametersMoved = false;
+
+        for (int start = 0; start < signal.getNumSamples();)
+        {
+            // About half the blocks full, the rest shorter
+            const int length = juce::jmin(random.nextBool() ? blockSize : 1 + random.nextInt(blockSize),
+                                          signal.getNumSamples() - start);
+
+            if (! parametersMoved && start >= parameterMove)
+            {
+                fixedLayout.setParameters(-36.0f, -18.0f, 6000.0f, 80);
+                generic.setParameters(-36.0f, -18.0f, 6000.0f, 80);
+                parametersMoved = true;
+            }
+
+            fixedLayout.process(fixedOutput, start, length);
+            generic.process(genericOutput, start, length);
+            start += length;
+        }
+
+        expect(TestAudio::bitwiseEqual(fixedOutput, genericOutput), "Output differs from the generic path");
+
+        DeEssEngine::State fixedState, genericState;
+        expect(fixedLayout.getState(fixedState) && generic.getState(genericState));
+        expect(fixedState == genericState, "State differs from the generic path");
+    }
+};
+
+static FixedLayoutTests fixedLayoutTests;
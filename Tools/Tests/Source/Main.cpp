@@ -0,0 +1,50 @@
+/*
+  ==============================================================================
+
+    Main.cpp
+    Created: 18 Oct 2026 10:04:12am
+    Author:  Leif Rehtanz
+
+    Runs every juce::UnitTest linked into this app, or those of one category,
+    and exits with 1 if any of them failed.
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include <iostream>
+
+int main(int argc, char* argv[])
+{
+    juce::ArgumentList args(argc, argv);
+
+    if (args.containsOption("--help|-h"))
+    {
+        std::cout << "Usage: DeEssDoctorTests [--category=<name>] [--seed=<n>]\n"
+                     "\n"
+                     "  --category=<name>  Only run the tests in this category\n"
+                     "  --seed=<n>         Seed for the tests' random input (default: random; the\n"
+                     "                     runner logs the seed it used, to repeat a failure)\n";
+        return 0;
+    }
+
+    // 0 lets the runner pick one
+    const auto seed = args.getValueForOption("--seed").getLargeIntValue();
+
+    juce::UnitTestRunner runner;
+    runner.setAssertOnFailure(false);
+
+    if (args.containsOption("--category"))
+        runner.runTestsInCategory(args.getValueForOption("--category"), seed);
+    else
+        runner.runAllTests(seed);
+
+    int numFailures = 0;
+
+    for (int i = 0; i < runner.getNumResults(); ++i)
+        numFailures += runner.getResult(i)->failures;
+
+    std::cout << "\n" << runner.getNumResults() << " tests run, " << numFailures << " failures\n";
+
+    return numFailures == 0 ? 0 : 1;
+}
@@ -0,0 +1,131 @@
+/*
+  ==============================================================================
+
+    RealtimeAllocationTests.cpp
+    Created: 18 Oct 2026 10:41:18am
+    Author:  Leif Rehtanz
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "../../../Source/AudioProcessorManager.h"
+#include "../../../Source/RealtimeAllocationChecker.h"
+
+#if ! DEESSDOCTOR_CHECK_REALTIME_ALLOCATIONS
+ #error "The tests need the allocation checker; build them with DEESSDOCTOR_CHECK_REALTIME_ALLOCATIONS=1"
+#endif
+
+// Drives AudioProcessorManager::processBlock() the way an audio device
+// would, with the allocation checker hooked into the global allocator, and
+// fails on any allocation or free made inside the audio path: every
+// algorithm and detection mode, block sizes the manager has to slice,
+// parameter moves and algorithm switches in the middle of playback.
+class RealtimeAllocationTests : public juce::UnitTest
+{
+public:
+    RealtimeAllocationTests() : juce::UnitTest("Real-time allocations", "DeEssDoctor") {}
+
+    void runTest() override
+    {
+        beginTest("The checker sees allocations");
+        {
+            RealtimeAllocationChecker::resetViolations();
+
+            {
+                RealtimeAllocationChecker::ScopedRealtimeSection realtimeSection;
+
+                // Called directly, so the compiler can't elide the pair
+                ::operator delete(::operator new(64));
+            }
+
+            expectEquals(RealtimeAllocationChecker::getNumViolations(), 2);
+            RealtimeAllocationChecker::resetViolations();
+        }
+
+        using Mode = DeEssEngine::Detection::Mode;
+        const std::pair<const char*, Mode> modes[] { { "per-sample", Mode::perSample },
+                                                     { "peak", Mode::peak },
+                                                     { "RMS", Mode::rms } };
+
+        for (const auto& entry : DeEssEngineRegistry::getEntries())
+        {
+            for (const auto& [modeName, mode] : modes)
+            {
+                for (const int numChannels : { 1, 2, 6 })
+                {
+                    beginTest(juce::String(entry.name) + ", " + modeName + " detection, "
+                              + juce::String(numChannels) + " channels");
+
+                    DeEssEngine::Detection detection;
+                    detection.mode = mode;
+                    expectNoAllocations(entry.algorithm, detection, numChannels);
+                }
+            }
+        }
+    }
+
+private:
+    static constexpr double sampleRate = 48000.0;
+    static constexpr int preparedBlockSize = 256;
+
+    void expectNoAllocations(DeEssEngineRegistry::Algorithm algorithm, const DeEssEngine::Detection& detection,
+                             int numChannels)
+    {
+        AudioProcessorManager manager;
+        SpectrumFifo spectrumFifo;
+
+        manager.setDetection(detection);
+        manager.setAlgorithm(algorithm);
+        manager.prepare(sampleRate, preparedBlockSize, numChannels);
+        manager.setSpectrumFifo(&spectrumFifo);
+
+        // Longer than prepared, so the manager slices, plus short and odd host blocks;
+        // one more channel than prepared, which passes through
+        juce::AudioBuffer<float> buffer(numChannels + 1, 3 * preparedBlockSize);
+        auto& random = getRandom();
+        const auto otherAlgorithm = algorithm == DeEssEngineRegistry::Algorithm::amplitudeThreshold
+                                        ? DeEssEngineRegistry::Algorithm::spectral
+                                        : DeEssEngineRegistry::Algorithm::amplitudeThreshold;
+
+        RealtimeAllocationChecker::resetViolations();
+
+        for (int block = 0; block < 400; ++block)
+        {
+            const int numSamples = block % 4 == 0 ? buffer.getNumSamples()
+                                                  : 1 + random.nextInt(preparedBlockSize);
+
+            for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
+                for (int i = 0; i < numSamples; ++i)
+                    buffer.setSample(channel, i, (random.nextFloat() * 2.0f - 1.0f) * (block % 3 == 0 ? 0.8f : 0.05f));
+
+            juce::AudioBuffer<float> hostBlock(buffer.getArrayOfWritePointers(), buffer.getNumChannels(), numSamples);
+
+            // Message-thread work between callbacks; only processBlock() is checked
+            if (block % 50 == 10)
+                manager.setDeEssingParameters(-40.0f + (float) random.nextInt(30), -12.0f,
+                                              4000.0f + 500.0f * (float) random.nextInt(8), 60.0f);
+
+            if (block == 150)
+                manager.setAlgorithm(otherAlgorithm);
+
+            if (block == 300)
+                manager.setAlgorithm(algorithm);
+
+            if (block % 20 == 0)
+                manager.releaseRetiredEngine();
+
+            manager.processBlock(hostBlock);
+
+            if (RealtimeAllocationChecker::getNumViolations() != 0)
+                break;
+        }
+
+        expectEquals(RealtimeAllocationChecker::getNumViolations(), 0, "The audio path allocated or freed memory");
+
+        manager.setSpectrumFifo(nullptr);
+        RealtimeAllocationChecker::resetViolations();
+    }
+};
+
+static RealtimeAllocationTests realtimeAllocationTests;
@@ -0,0 +1,137 @@
+/*
+  ==============================================================================
+
+    TestAudio.h
+    Created: 18 Oct 2026 7:24:05pm
+    Author:  Leif Rehtanz
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "../../../Source/OfflineRenderer.h"
+
+// Signals, readers and comparisons shared by the tests that render audio
+namespace TestAudio
+{
+    // Reads a buffer held in memory, as if it were a 32-bit float file
+    class BufferReader : public juce::AudioFormatReader
+    {
+    public:
+        BufferReader(const juce::AudioBuffer<float>& bufferToRead, double rate)
+            : juce::AudioFormatReader(nullptr, "Buffer"),
+              source(bufferToRead)
+        {
+            sampleRate = rate;
+            bitsPerSample = 32;
+            lengthInSamples = source.getNumSamples();
+            numChannels = (unsigned int) source.getNumChannels();
+            usesFloatingPointData = true;
+        }
+
+        bool readSamples(int* const* destChannels, int numDestChannels, int startOffsetInDestBuffer,
+                         juce::int64 startSampleInFile, int numSamples) override
+        {
+            clearSamplesBeyondAvailableLength(destChannels, numDestChannels, startOffsetInDestBuffer,
+                                              startSampleInFile, numSamples, lengthInSamples);
+
+            if (numSamples <= 0)
+                return true;
+
+            for (int channel = 0; channel < numDestChannels; ++channel)
+            {
+                if (auto* dest = reinterpret_cast<float*>(destChannels[channel]))
+                {
+                    if (channel < source.getNumChannels())
+                        juce::FloatVectorOperations::copy(dest + startOffsetInDestBuffer,
+                                                          source.getReadPointer(channel, (int) startSampleInFile),
+                                                          numSamples);
+                    else
+                        juce::FloatVectorOperations::clear(dest + startOffsetInDestBuffer, numSamples);
+                }
+            }
+
+            return true;
+        }
+
+    private:
+        const juce::AudioBuffer<float>& source;
+    };
+
+    // Three seconds of stereo: a low tone under quiet noise, with a loud noise
+    // burst, the sibilant, every 0.8 seconds
+    inline juce::AudioBuffer<float> createSpeechLikeSignal(juce::Random& random, double sampleRate)
+    {
+        const int numSamples = (int) (3.0 * sampleRate);
+        const int burstPeriod = (int) (0.2 * sampleRate);
+        juce::AudioBuffer<float> signal(2, numSamples);
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            const bool isSibilant = (i / burstPeriod) % 4 == 1;
+            const auto tone = 0.3f * (float) std::sin(juce::MathConstants<double>::twoPi * 200.0 * i / sampleRate);
+
+            for (int channel = 0; channel < signal.getNumChannels(); ++channel)
+            {
+                const auto noise = random.nextFloat() * 2.0f - 1.0f;
+                signal.setSample(channel, i, tone + noise * (isSibilant ? 0.35f : 0.0035f));
+            }
+        }
+
+        return signal;
+    }
+
+    inline bool bitwiseEqual(const juce::AudioBuffer<float>& a, const juce::AudioBuffer<float>& b)
+    {
+        if (a.getNumChannels() != b.getNumChannels() || a.getNumSamples() != b.getNumSamples())
+            return false;
+
+        for (int channel = 0; channel < a.getNumChannels(); ++channel)
+            if (std::memcmp(a.getReadPointer(channel), b.getReadPointer(channel), sizeof(float) * (size_t) a.getNumSamples()) != 0)
+                return false;
+
+        return true;
+    }
+
+    // Appends each rendered block to output, failing once it's full
+    inline OfflineRenderer::BlockWriter writeTo(juce::AudioBuffer<float>& output, int& numWritten)
+    {
+        return [&output, &numWritten] (const juce::AudioBuffer<float>& block, int startSample, int numSamples)
+        {
+            if (numWritten + numSamples > output.getNumSamples())
+                return false;
+
+            for (int channel = 0; channel < output.getNumChannels(); ++channel)
+                juce::FloatVectorOperations::copy(output.getWritePointer(channel, numWritten),
+                                                  block.getReadPointer(channel, startSample), numSamples);
+
+            numWritten += numSamples;
+            return true;
+        };
+    }
+
+    // Renders input in one pass and in chunks, and expects the chunked render
+    // to match it bit for bit without any chunk being rendered again
+    inline void expectChunkedMatchesSinglePass(juce::UnitTest& test, const juce::AudioBuffer<float>& input,
+                                               double sampleRate, const OfflineRenderer::Settings& settings)
+    {
+        juce::AudioBuffer<float> singlePass(input.getNumChannels(), input.getNumSamples());
+        juce::AudioBuffer<float> chunked(input.getNumChannels(), input.getNumSamples());
+        int numSinglePassSamples = 0, numChunkedSamples = 0;
+
+        OfflineRenderer renderer;
+        BufferReader reader(input, sampleRate);
+        const auto singlePassResult = renderer.render(reader, writeTo(singlePass, numSinglePassSamples), settings);
+        const auto chunkedResult = renderer.renderChunked([&input, sampleRate] { return std::make_unique<BufferReader>(input, sampleRate); },
+                                                          writeTo(chunked, numChunkedSamples), settings);
+
+        test.expect(singlePassResult.wasSuccessful() && chunkedResult.wasSuccessful());
+        test.expectEquals(numSinglePassSamples, input.getNumSamples());
+        test.expectEquals(numChunkedSamples, input.getNumSamples());
+        test.expect(chunkedResult.numChunks > 1, "The input wasn't split into chunks");
+        test.expect(bitwiseEqual(chunked, singlePass), "Chunked output differs from the single-pass render");
+        test.expectEquals(chunkedResult.numChunksRerendered, 0, "Chunks were rendered again");
+    }
+}